@@ -0,0 +1,21 @@
+package org.lflang.target.property;
+
+/**
+ * If true, generate a benchmark harness instead of the regular main function. The harness performs
+ * warmup iterations, measures repeated runs of the program, and reports percentile statistics,
+ * optionally as JSON.
+ */
+public final class BenchmarkProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final BenchmarkProperty INSTANCE = new BenchmarkProperty();
+
+  private BenchmarkProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "benchmark";
+  }
+}
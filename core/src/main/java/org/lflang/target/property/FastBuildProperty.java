@@ -0,0 +1,20 @@
+package org.lflang.target.property;
+
+/**
+ * If true, speed up compilation of the generated code by precompiling the runtime's umbrella header
+ * and batching the generated sources into unity builds.
+ */
+public final class FastBuildProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final FastBuildProperty INSTANCE = new FastBuildProperty();
+
+  private FastBuildProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "fast-build";
+  }
+}
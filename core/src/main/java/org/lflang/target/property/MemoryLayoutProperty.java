@@ -0,0 +1,48 @@
+package org.lflang.target.property;
+
+import org.lflang.MessageReporter;
+import org.lflang.ast.ASTUtils;
+import org.lflang.lf.Element;
+import org.lflang.target.property.type.MemoryLayoutType;
+import org.lflang.target.property.type.MemoryLayoutType.MemoryLayout;
+
+/** Directive for specifying how reactor banks are laid out in memory. */
+public final class MemoryLayoutProperty extends TargetProperty<MemoryLayout, MemoryLayoutType> {
+
+  /** Singleton target property instance. */
+  public static final MemoryLayoutProperty INSTANCE = new MemoryLayoutProperty();
+
+  private MemoryLayoutProperty() {
+    super(new MemoryLayoutType());
+  }
+
+  @Override
+  public MemoryLayout initialValue() {
+    return MemoryLayout.getDefault();
+  }
+
+  @Override
+  public MemoryLayout fromAst(Element node, MessageReporter reporter) {
+    var layout = fromString(ASTUtils.elementToSingleString(node), reporter);
+    if (layout != null) {
+      return layout;
+    } else {
+      return MemoryLayout.getDefault();
+    }
+  }
+
+  @Override
+  protected MemoryLayout fromString(String string, MessageReporter reporter) {
+    return this.type.forName(string);
+  }
+
+  @Override
+  public Element toAstElement(MemoryLayout value) {
+    return ASTUtils.toElement(value.toString());
+  }
+
+  @Override
+  public String name() {
+    return "memory-layout";
+  }
+}
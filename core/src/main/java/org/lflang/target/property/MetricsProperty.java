@@ -0,0 +1,20 @@
+package org.lflang.target.property;
+
+/**
+ * If true, instrument the generated reactions with cheap per-reaction counters and add a
+ * --metrics-port option to the generated program that serves them in Prometheus format.
+ */
+public final class MetricsProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final MetricsProperty INSTANCE = new MetricsProperty();
+
+  private MetricsProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "metrics";
+  }
+}
@@ -0,0 +1,21 @@
+package org.lflang.target.property;
+
+/**
+ * If true, enable rclcpp intra-process communication for the generated ROS2 node, so that
+ * node-internal topics bypass serialization and the middleware. This is opt-in because
+ * intra-process communication restricts the QoS settings a node may use.
+ */
+public final class Ros2IntraProcessProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final Ros2IntraProcessProperty INSTANCE = new Ros2IntraProcessProperty();
+
+  private Ros2IntraProcessProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "ros2-intra-process";
+  }
+}
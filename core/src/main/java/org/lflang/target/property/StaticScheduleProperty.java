@@ -0,0 +1,20 @@
+package org.lflang.target.property;
+
+/**
+ * If true, compute the reaction dependency graph at code generation time and emit it as
+ * compile-time data alongside the generated program.
+ */
+public final class StaticScheduleProperty extends BooleanProperty {
+
+  /** Singleton target property instance. */
+  public static final StaticScheduleProperty INSTANCE = new StaticScheduleProperty();
+
+  private StaticScheduleProperty() {
+    super();
+  }
+
+  @Override
+  public String name() {
+    return "static-schedule";
+  }
+}
@@ -0,0 +1,49 @@
+package org.lflang.target.property.type;
+
+import java.util.Arrays;
+import java.util.List;
+import java.util.stream.Collectors;
+import org.lflang.target.property.type.MemoryLayoutType.MemoryLayout;
+
+/** Enumeration of supported memory layouts for reactor instantiation. */
+public class MemoryLayoutType extends OptionsType<MemoryLayout> {
+
+  @Override
+  protected Class<MemoryLayout> enumClass() {
+    return MemoryLayout.class;
+  }
+
+  /**
+   * Enumeration of memory layouts for reactor bank instantiation.
+   *
+   * <p>With the default layout, each bank member is allocated individually on the heap. With the
+   * arena layout, all members of a bank are allocated from one contiguous per-bank arena, which
+   * keeps the scheduler's walk over bank members cache-resident.
+   */
+  public enum MemoryLayout {
+    DEFAULT("default"),
+    ARENA("arena");
+
+    /** Alias used in toString method. */
+    private final String alias;
+
+    /** Private constructor for memory layouts. */
+    MemoryLayout(String alias) {
+      this.alias = alias;
+    }
+
+    /** Return the alias. */
+    @Override
+    public String toString() {
+      return this.alias;
+    }
+
+    public static List<MemoryLayout> optionsList() {
+      return Arrays.stream(MemoryLayout.values()).collect(Collectors.toList());
+    }
+
+    public static MemoryLayout getDefault() {
+      return MemoryLayout.DEFAULT;
+    }
+  }
+}
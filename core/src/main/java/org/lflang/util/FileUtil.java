@@ -906,6 +906,10 @@ public class FileUtil {
   public static boolean isSame(String text, Path path) throws IOException {
     if (Files.isRegularFile(path)) {
       final byte[] bytes = text.getBytes();
+      // comparing sizes first avoids reading the old file when the content obviously differs
+      if (bytes.length != Files.size(path)) {
+        return false;
+      }
       return Arrays.equals(bytes, Files.readAllBytes(path));
     }
     return false;
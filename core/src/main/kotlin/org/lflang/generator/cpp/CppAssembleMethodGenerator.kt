@@ -37,6 +37,7 @@ import org.lflang.lf.Reaction
 import org.lflang.lf.Reactor
 import org.lflang.lf.TriggerRef
 import org.lflang.lf.VarRef
+import org.lflang.lf.WidthSpec
 
 /**
  * A code generator for the assemble() method of a C++ reactor class
@@ -175,11 +176,94 @@ class CppAssembleMethodGenerator(private val reactor: Reactor) {
     private val VarRef.portType: String
         get() = "reactor::Port<typename ${dataType}>*"
 
+    /** The width of this spec if it is fully determined by integer literals, or null otherwise. */
+    private val WidthSpec.staticWidth: Int?
+        get() {
+            if (terms.isEmpty() || terms.any { it.parameter != null || it.port != null || it.code != null }) {
+                return null
+            }
+            return terms.sumOf { it.width }
+        }
+
+    /**
+     * Return C++ expressions referencing each individual port that the given reference expands to, or null
+     * if the number of ports is not known at code generation time.
+     *
+     * The expansion order matches the loops generated by [iterateOverAllPortsAndApply], including the
+     * flipped iteration order for interleaved references.
+     */
+    private fun staticPortReferences(varRef: VarRef): List<String>? {
+        val port = varRef.variable as Port
+        val container: Instantiation? = varRef.container
+        val instanceRef = if (container?.isEnclave == true) "__lf_instance->" else ""
+
+        val bankWidth = if (container?.isBank == true) container.widthSpec.staticWidth ?: return null else null
+        val portWidth = if (port.isMultiport) port.widthSpec.staticWidth ?: return null else null
+
+        return when {
+            bankWidth != null && portWidth != null ->
+                if (varRef.isInterleaved) {
+                    (0 until portWidth).flatMap { p ->
+                        (0 until bankWidth).map { b -> "${container!!.name}[$b]->$instanceRef${port.name}[$p]" }
+                    }
+                } else {
+                    (0 until bankWidth).flatMap { b ->
+                        (0 until portWidth).map { p -> "${container!!.name}[$b]->$instanceRef${port.name}[$p]" }
+                    }
+                }
+
+            bankWidth != null -> (0 until bankWidth).map { b -> "${container!!.name}[$b]->$instanceRef${port.name}" }
+            portWidth != null -> (0 until portWidth).map { p -> "${varRef.name}[$p]" }
+            else              -> listOf(varRef.name)
+        }
+    }
+
+    /**
+     * Generate a statically resolved version of a multiport connection.
+     *
+     * All port references are placed in flat arrays with sizes fixed at code generation time, and the
+     * connections are drawn directly without going through lfutil::bind_multiple_ports.
+     */
+    private fun declareStaticConnection(c: Connection, idx: Int, leftPorts: List<String>, rightPorts: List<String>): String {
+        val portType = c.leftPorts[0].portType
+        return with(PrependOperator) {
+            """
+                |// connection $idx (widths resolved at code generation time)
+                |$portType const __lf_left_ports_$idx[${leftPorts.size}] = {
+            ${" |  "..leftPorts.joinToString(",\n") { "&$it" }}
+                |};
+                |$portType const __lf_right_ports_$idx[${rightPorts.size}] = {
+            ${" |  "..rightPorts.joinToString(",\n") { "&$it" }}
+                |};
+                |for (std::size_t __lf_idx = 0; __lf_idx < ${rightPorts.size}; __lf_idx++) {
+                |  this->environment()->draw_connection(__lf_left_ports_$idx[__lf_idx % ${leftPorts.size}], __lf_right_ports_$idx[__lf_idx], ${c.properties});
+                |}
+            """.trimMargin()
+        }
+    }
+
     private fun declareMultiportConnection(c: Connection, idx: Int): String {
         // It should be safe to assume that all ports have the same type. Thus we just pick the
         // first left port to determine the type of the entire connection
         val portType = c.leftPorts[0].portType
 
+        // If all bank and multiport widths are known at code generation time, we can wire the
+        // connection through flat, fixed-size port tables instead of assembling vectors at startup.
+        // We only do this when the widths match up exactly (considering repetition of the left ports
+        // for iterated connections), so that the runtime warnings about dangling ports are preserved
+        // on the dynamic path.
+        val staticLeft = c.leftPorts.mapNotNull { staticPortReferences(it) }
+        val staticRight = c.rightPorts.mapNotNull { staticPortReferences(it) }
+        if (staticLeft.size == c.leftPorts.size && staticRight.size == c.rightPorts.size) {
+            val leftPorts = staticLeft.flatten()
+            val rightPorts = staticRight.flatten()
+            val widthsMatch =
+                if (c.isIterated) rightPorts.size % leftPorts.size == 0 else leftPorts.size == rightPorts.size
+            if (widthsMatch) {
+                return declareStaticConnection(c, idx, leftPorts, rightPorts)
+            }
+        }
+
         // Generate code which adds all left hand ports and all right hand ports to a vector each. If we are handling multiports
         // within a bank, then we normally iterate over all banks in an outer loop and over all ports in an inner loop. However,
         // if the connection is an interleaved connection, than we change the order on the right side and iterate over ports before banks.
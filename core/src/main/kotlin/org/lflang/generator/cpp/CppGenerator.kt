@@ -163,7 +163,7 @@ class CppGenerator(
     private fun generateFiles(srcGenPath: Path, resources: Set<Resource>) {
         // copy static library files over to the src-gen directory
         val genIncludeDir = srcGenPath.resolve("__include__")
-        listOf("lfutil.hh", "time_parser.hh").forEach {
+        listOf("lfutil.hh", "lf_logging.hh", "time_parser.hh", "lf_tracing.hh", "lf_metrics.hh", "lf_ros2.hh", "lf_serial.hh", "lf_pool.hh").forEach {
             FileUtil.copyFileFromClassPath("$libDir/$it", genIncludeDir, true)
         }
         FileUtil.copyFileFromClassPath(
@@ -187,7 +187,7 @@ class CppGenerator(
 
         // generate header and source files for all reactors
         for (r in reactors) {
-            val generator = CppReactorGenerator(r, fileConfig, messageReporter)
+            val generator = CppReactorGenerator(r, fileConfig, targetConfig, messageReporter)
             val headerFile = fileConfig.getReactorHeaderPath(r)
             val sourceFile = if (r.isGeneric) fileConfig.getReactorHeaderImplPath(r) else fileConfig.getReactorSourcePath(r)
             val reactorCodeMap = CodeMap.fromGeneratedCode(generator.generateSource())
@@ -28,12 +28,16 @@ import org.lflang.*
 import org.lflang.generator.PrependOperator
 import org.lflang.lf.Instantiation
 import org.lflang.lf.Reactor
+import org.lflang.target.TargetConfig
+import org.lflang.target.property.MemoryLayoutProperty
+import org.lflang.target.property.type.MemoryLayoutType.MemoryLayout
 import org.lflang.validation.AttributeSpec
 
 /** A code generator for reactor instances */
 class CppInstanceGenerator(
     private val reactor: Reactor,
     private val fileConfig: CppFileConfig,
+    private val targetConfig: TargetConfig,
     private val messageReporter: MessageReporter
 ) {
     companion object {
@@ -61,26 +65,50 @@ class CppInstanceGenerator(
             |  ${if (!hasEachParameter) "inline static " else ""}std::unique_ptr<reactor::Environment> __lf_env{nullptr};
             |  std::unique_ptr<$reactorType> __lf_instance{nullptr};
             |  
-            |  $enclaveWrapperClassName(const std::string& name, reactor::Reactor* container, $reactorType::Parameters&& params) {
+            |  // creating the environment registers it with the parent environment and must run serially
+            |  $enclaveWrapperClassName(const std::string& name, reactor::Reactor* container) {
             |    if (__lf_env == nullptr) {
             |      __lf_env = std::make_unique<reactor::Environment>(container->fqn() + name, container->environment());
             |    }
+            |  }
+            |
+            |  $enclaveWrapperClassName(const std::string& name, reactor::Reactor* container, $reactorType::Parameters&& params)
+            |      : $enclaveWrapperClassName(name, container) {
+            |    instantiate(name, std::forward<$reactorType::Parameters>(params));
+            |  }
+            |
+            |  // the instance only touches its own environment, so instantiation of different wrappers
+            |  // may run concurrently
+            |  void instantiate(const std::string& name, $reactorType::Parameters&& params) {
             |    __lf_instance = std::make_unique<$reactorType>(name, __lf_env.get(), std::forward<$reactorType::Parameters>(params));
             |  }
             |};
         """.trimMargin()
 
+    /** Whether bank members should be constructed in a contiguous per-bank arena. */
+    private val useArenaLayout: Boolean
+        get() = targetConfig.get(MemoryLayoutProperty.INSTANCE) == MemoryLayout.ARENA
+
     private fun generateDeclaration(inst: Instantiation): String = with(inst) {
-        val instance = if (isBank) "std::vector<std::unique_ptr<$cppClass>>" else "std::unique_ptr<$cppClass>"
+        val instance = when {
+            isBank && useArenaLayout -> "std::vector<lfutil::arena_ptr<$cppClass>>"
+            isBank                   -> "std::vector<std::unique_ptr<$cppClass>>"
+            else                     -> "std::unique_ptr<$cppClass>"
+        }
+        // In arena mode, the arena must be declared before the bank vector so that the bank members
+        // are destroyed before their backing storage is released.
+        val declaration =
+            if (isBank && useArenaLayout) "lfutil::ReactorArena ${name}_arena;\n$instance $name;"
+            else "$instance $name;"
         if (isEnclave) {
             return with(PrependOperator) {
                 """
                 ${" |"..inst.generateWrapper()}
-                    |$instance $name;
+                    |$declaration
                 """.trimMargin()
             }
         }
-        return "$instance $name;"
+        return declaration
     }
 
     private fun Instantiation.getParameterStruct(): String {
@@ -114,12 +142,48 @@ class CppInstanceGenerator(
         with(inst) {
             assert(isBank)
             val width = inst.widthSpec.toCppCode()
+            if (isEnclave && hasEachParameter) {
+                // Each member owns a private environment, so instantiating the members (and thus
+                // constructing their complete reactor trees) is independent work that can be
+                // spread across the assembly workers. Only the environment creation, which
+                // registers with the shared parent environment, stays serial.
+                val reserveArena =
+                    if (useArenaLayout) "${name}_arena.reserve($width * sizeof($cppClass) + alignof($cppClass));\n" else ""
+                val createWrapper =
+                    if (useArenaLayout) "${name}_arena.create<$cppClass>(__lf_inst_name, this)"
+                    else "std::make_unique<$cppClass>(__lf_inst_name, this)"
+                return """
+                    |// initialize instance $name; each member owns a private environment, so the
+                    |// members are instantiated in parallel across the assembly workers
+                    |$reserveArena$name.reserve($width);
+                    |lfutil::InstanceNames ${name}_names{"$name"};
+                    |for (size_t __lf_idx = 0; __lf_idx < $width; __lf_idx++) {
+                    |  const std::string& __lf_inst_name = ${name}_names.of(__lf_idx);
+                    |  $name.emplace_back($createWrapper);
+                    |}
+                    |lfutil::parallel_for($width, [this](std::size_t __lf_idx) {
+                    |  std::string __lf_inst_name = "${name}_" + std::to_string(__lf_idx);
+                    |  $name[__lf_idx]->instantiate(__lf_inst_name, ${inst.getParameterStruct()});
+                    |});
+                """.trimMargin()
+            }
+            if (useArenaLayout) {
+                return """
+                    |// initialize instance $name from a contiguous arena
+                    |${name}_arena.reserve($width * sizeof($cppClass) + alignof($cppClass));
+                    |$name.reserve($width);
+                    |lfutil::InstanceNames ${name}_names{"$name"};
+                    |for (size_t __lf_idx = 0; __lf_idx < $width; __lf_idx++) {
+                    |  $name.emplace_back(${name}_arena.create<$cppClass>(${name}_names.of(__lf_idx), this, ${inst.getParameterStruct()}));
+                    |}
+                """.trimMargin()
+            }
             return """
                 |// initialize instance $name
                 |$name.reserve($width);
+                |lfutil::InstanceNames ${name}_names{"$name"};
                 |for (size_t __lf_idx = 0; __lf_idx < $width; __lf_idx++) {
-                |  std::string __lf_inst_name = "${name}_" + std::to_string(__lf_idx);
-                |  $name.emplace_back(std::make_unique<$cppClass>(__lf_inst_name, this, ${inst.getParameterStruct()}));
+                |  $name.emplace_back(std::make_unique<$cppClass>(${name}_names.of(__lf_idx), this, ${inst.getParameterStruct()}));
                 |}
             """.trimMargin()
         }
@@ -27,12 +27,18 @@ package org.lflang.generator.cpp
 import org.lflang.generator.PrependOperator
 import org.lflang.generator.cpp.CppInstanceGenerator.Companion.cppClass
 import org.lflang.isBank
+import org.lflang.target.TargetConfig
+import org.lflang.target.property.MemoryLayoutProperty
+import org.lflang.target.property.MetricsProperty
+import org.lflang.target.property.TracingProperty
+import org.lflang.target.property.type.MemoryLayoutType.MemoryLayout
 import org.lflang.joinWithLn
 import org.lflang.label
 import org.lflang.lf.Action
 import org.lflang.lf.BuiltinTrigger
 import org.lflang.lf.BuiltinTriggerRef
 import org.lflang.lf.Instantiation
+import org.lflang.lf.ParameterReference
 import org.lflang.lf.Port
 import org.lflang.lf.Reaction
 import org.lflang.lf.Reactor
@@ -45,11 +51,19 @@ import org.lflang.toText
 /** A C++ code generator for reactions and their function bodies */
 class CppReactionGenerator(
     private val reactor: Reactor,
+    private val targetConfig: TargetConfig,
     private val portGenerator: CppPortGenerator
 ) {
 
     private val reactionsWithDeadlines = reactor.reactions.filter { it.deadline != null }
 
+    /** The type of the owning pointers held by the vector representing a bank of reactors. */
+    private val Instantiation.bankPtrType: String
+        get() = if (targetConfig.get(MemoryLayoutProperty.INSTANCE) == MemoryLayout.ARENA)
+            "lfutil::arena_ptr<$cppClass>"
+        else
+            "std::unique_ptr<$cppClass>"
+
     private val VarRef.isContainedRef: Boolean get() = container != null
     private val TriggerRef.isContainedRef: Boolean get() = this is VarRef && isContainedRef
 
@@ -70,6 +84,10 @@ class CppReactionGenerator(
     private fun Reaction.getViewClassName(container: Instantiation) = "__lf_view_of_${codeName}_on_${container.name}_t"
     private fun Reaction.getViewInstanceName(container: Instantiation) = "__lf_view_of_${codeName}_on_${container.name}"
 
+    /** The type of the non-owning view over all bank members referenced by this reaction. */
+    private fun Reaction.getBankViewType(container: Instantiation) =
+        "lfutil::BankView<${getViewClassName(container)}, ${container.bankPtrType}>"
+
     private val VarRef.cppType
         get() =
             when (val variable = this.variable) {
@@ -92,10 +110,20 @@ class CppReactionGenerator(
                 allUncontainedSources.map { "const ${it.cppType}& ${it.name}" } +
                 allUncontainedEffects.map { "${it.cppType}& ${it.name}" } +
                 allReferencedContainers.map {
-                    if (it.isBank) "const std::vector<${getViewClassName(it)}>& ${it.name}"
+                    if (it.isBank) "const ${getBankViewType(it)}& ${it.name}"
                     else "${getViewClassName(it)}& ${it.name}"
                 }
 
+    /*
+     * Note on dispatch cost: the runtime's Reaction class stores its body as a type-erased
+     * std::function, so every invocation makes exactly one indirect call that the optimizer cannot
+     * devirtualize from here — a statically dispatched form would need a template or virtual-slot
+     * variant of Reaction in the runtime itself. What generated code controls is everything behind
+     * that call: the lambda and the _body forwarder below are defined inline in the header, so the
+     * whole chain down to the reaction body collapses into one call frame. The body definition
+     * lives in the translation unit of its reactor; building with `build-type: RelWithLTO` lets it
+     * inline across that boundary as well.
+     */
     private fun generateDeclaration(r: Reaction): String {
         with(r) {
             val parameters = allUncontainedTriggers.map { it.name } +
@@ -150,6 +178,37 @@ class CppReactionGenerator(
         }
     }
 
+    /** Get a trace point wrapping the execution of a reaction body, or nothing if tracing is disabled. */
+    private fun generateTracePoint(reaction: Reaction, postfix: String?): String =
+        if (targetConfig.get(TracingProperty.INSTANCE).isEnabled)
+            """lfutil::tracing::ScopedTrace __lf_trace{"${reactor.name}.${reaction.codeName}${if (postfix != null) ".$postfix" else ""}", get_tag()};"""
+        else ""
+
+    private fun generateMeasurePoint(reaction: Reaction): String =
+        if (targetConfig.get(MetricsProperty.INSTANCE))
+            """
+                |static auto& __lf_stats = lfutil::metrics::Registry::instance().reaction("${reactor.name}.${reaction.codeName}");
+                |lfutil::metrics::ScopedMeasure __lf_measure{__lf_stats, get_tag()};
+            """.trimMargin()
+        else ""
+
+    private fun generateNearMissCheck(reaction: Reaction): String {
+        if (!targetConfig.get(MetricsProperty.INSTANCE) || reaction.deadline == null) return ""
+        val delay = reaction.deadline.delay
+        val value = if (delay is ParameterReference) delay.parameter.name else delay.toCppTime()
+        return """
+            |// count a near-miss if less than a tenth of the deadline is left when the body starts
+            |if (reactor::get_physical_time() - get_tag().time_point() > ($value) - ($value) / 10) {
+            |  lfutil::metrics::Registry::instance().count_deadline_near_miss();
+            |}
+        """.trimMargin()
+    }
+
+    private fun generateDeadlineMissCount(): String =
+        if (targetConfig.get(MetricsProperty.INSTANCE))
+            "lfutil::metrics::Registry::instance().count_deadline_miss();"
+        else ""
+
     private fun generateBodyDefinition(reaction: Reaction): String? {
         return if (reaction.code == null) null
         else with(PrependOperator) {
@@ -157,6 +216,9 @@ class CppReactionGenerator(
                 |// reaction ${reaction.label}
                 |${reactor.templateLine}
             ${" |"..getFunctionDefinitionSignature(reaction, null)} {
+            ${" |  "..generateTracePoint(reaction, null)}
+            ${" |  "..generateMeasurePoint(reaction)}
+            ${" |  "..generateNearMissCheck(reaction)}
             ${" |  "..reaction.code.toText()}
                 |}
                 |
@@ -168,6 +230,8 @@ class CppReactionGenerator(
         return """
             |${reactor.templateLine}
         ${" |"..getFunctionDefinitionSignature(reaction, "deadline_handler")} {
+        ${" |  "..generateTracePoint(reaction, "deadline_handler")}
+        ${" |  "..generateDeadlineMissCount()}
         ${" |  "..reaction.deadline.code.toText()}
             |}
             |
@@ -187,7 +251,7 @@ class CppReactionGenerator(
         val initializers = variables.map { "${it.variable.name}(reactor->${it.variable.name})" }
 
         val viewDeclaration =
-            if (container.isBank) "std::vector<$viewClass> $viewInstance;"
+            if (container.isBank) "${r.getBankViewType(container)} $viewInstance;"
             else "$viewClass $viewInstance;"
 
         return with(PrependOperator) {
@@ -207,20 +271,12 @@ class CppReactionGenerator(
         r.allReferencedContainers.joinWithLn { generateViewForContainer(r, it) }
 
     private fun generateViewInitializers(r: Reaction) =
-        r.allReferencedContainers.filterNot { it.isBank }
-            .joinWithLn { ", ${r.getViewInstanceName(it)}(${it.name}.get()) " }
-
-    private fun generateViewConstructorInitializers(r: Reaction) =
-        r.allReferencedContainers.filter { it.isBank }
-            .joinWithLn {
-                val viewInstance = r.getViewInstanceName(it)
-                """
-                    $viewInstance.reserve(${it.name}.size());
-                    for (auto& __lf_instance : ${it.name}) {
-                      $viewInstance.emplace_back(__lf_instance.get());
-                    }
-                """.trimIndent()
-            }
+        r.allReferencedContainers.joinWithLn {
+            // Bank views only record a reference to the bank vector, which is filled later in the
+            // constructor body. Views on individual instances reference the instance directly.
+            if (it.isBank) ", ${r.getViewInstanceName(it)}(${it.name}) "
+            else ", ${r.getViewInstanceName(it)}(${it.name}.get()) "
+        }
 
     fun generateReactionViews() =
         reactor.reactions.joinToString(separator = "\n", prefix = "// reaction views\n", postfix = "\n") { generateViews(it) }
@@ -238,11 +294,6 @@ class CppReactionGenerator(
         return classNames.joinWithLn(prefix = "// reaction view forward declarations\n") { "struct $it;" }
     }
 
-    fun generateReactionViewConstructorInitializers() =
-        reactor.reactions.joinToString(separator = "\n", prefix = "// reaction views\n", postfix = "\n") {
-            generateViewConstructorInitializers(it)
-        }
-
     /** Get all reaction declarations. */
     fun generateDeclarations() =
         reactor.reactions.joinToString(separator = "\n", prefix = "// reactions\n", postfix = "\n") { generateDeclaration(it) }
@@ -27,13 +27,16 @@ import org.lflang.MessageReporter
 import org.lflang.generator.PrependOperator
 import org.lflang.isGeneric
 import org.lflang.lf.Reactor
+import org.lflang.target.TargetConfig
+import org.lflang.target.property.MetricsProperty
+import org.lflang.target.property.TracingProperty
 import org.lflang.toText
 import org.lflang.toUnixString
 
 /**
  * A C++ code generator that produces a C++ class representing a single reactor
  */
-class CppReactorGenerator(private val reactor: Reactor, fileConfig: CppFileConfig, messageReporter: MessageReporter) {
+class CppReactorGenerator(private val reactor: Reactor, fileConfig: CppFileConfig, private val targetConfig: TargetConfig, messageReporter: MessageReporter) {
 
     /** Comment to be inserted at the top of generated files */
     private val fileComment = fileComment(reactor.eResource())
@@ -50,11 +53,11 @@ class CppReactorGenerator(private val reactor: Reactor, fileConfig: CppFileConfi
     private val parameters = CppParameterGenerator(reactor)
     private val state = CppStateGenerator(reactor)
     private val methods = CppMethodGenerator(reactor)
-    private val instances = CppInstanceGenerator(reactor, fileConfig, messageReporter)
+    private val instances = CppInstanceGenerator(reactor, fileConfig, targetConfig, messageReporter)
     private val timers = CppTimerGenerator(reactor)
     private val actions = CppActionGenerator(reactor, messageReporter)
     private val ports = CppPortGenerator(reactor)
-    private val reactions = CppReactionGenerator(reactor, ports)
+    private val reactions = CppReactionGenerator(reactor, targetConfig, ports)
     private val assemble = CppAssembleMethodGenerator(reactor)
 
     private fun publicPreamble() =
@@ -74,6 +77,9 @@ class CppReactorGenerator(private val reactor: Reactor, fileConfig: CppFileConfi
             |
             |#include "reactor-cpp/reactor-cpp.hh"
             |#include "lfutil.hh"
+            |#include "lf_logging.hh"
+            |${if (targetConfig.get(TracingProperty.INSTANCE).isEnabled) """#include "lf_tracing.hh"""" else ""}
+            |${if (targetConfig.get(MetricsProperty.INSTANCE)) """#include "lf_metrics.hh"""" else ""}
             |
             |using namespace std::chrono_literals;
             |
@@ -188,7 +194,6 @@ class CppReactorGenerator(private val reactor: Reactor, fileConfig: CppFileConfi
                 |{
             ${" |  "..ports.generateConstructorInitializers()}
             ${" |  "..instances.generateConstructorInitializers()}
-            ${" |  "..reactions.generateReactionViewConstructorInitializers()}
                 |}
             """.trimMargin()
         }
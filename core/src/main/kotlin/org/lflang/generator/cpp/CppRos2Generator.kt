@@ -42,7 +42,7 @@ class CppRos2Generator(generator: CppGenerator) : CppPlatformGenerator(generator
                 fileConfig.srcGenPath.resolve(relativeBinDir).resolve(fileConfig.name)
             else
                 fileConfig.binPath.resolve(fileConfig.name)
-        FileUtil.writeToFile(packageGenerator.generateBinScript(), scriptPath)
+        FileUtil.writeToFile(packageGenerator.generateBinScript(), scriptPath, true)
         scriptPath.toFile().setExecutable(true);
     }
 
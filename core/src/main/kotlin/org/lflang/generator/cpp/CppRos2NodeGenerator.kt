@@ -3,6 +3,7 @@ package org.lflang.generator.cpp
 import org.lflang.target.TargetConfig
 import org.lflang.lf.Reactor
 import org.lflang.target.property.FastProperty
+import org.lflang.target.property.Ros2IntraProcessProperty
 import org.lflang.target.property.TimeOutProperty
 import org.lflang.target.property.WorkersProperty
 import org.lflang.toUnixString
@@ -47,6 +48,13 @@ class CppRos2NodeGenerator(
     }
 
     fun generateSource(): String {
+        // Intra-process communication lets node-internal topics bypass serialization and the
+        // middleware, but it constrains the QoS settings the node may use, so it is only enabled
+        // when explicitly requested via the ros2-intra-process target property.
+        val nodeOptions =
+            if (targetConfig.get(Ros2IntraProcessProperty.INSTANCE))
+                "rclcpp::NodeOptions(node_options).use_intra_process_comms(true)"
+            else "node_options"
         return """
             |#include "$nodeName.hh"
             |#include <rclcpp_components/register_node_macro.hpp>
@@ -59,7 +67,7 @@ class CppRos2NodeGenerator(
             |}
             |
             |$nodeName::$nodeName(const rclcpp::NodeOptions& node_options)
-            |  : Node("$nodeName", node_options) {
+            |  : Node("$nodeName", $nodeOptions) {
             |  unsigned workers = ${if (targetConfig.get(WorkersProperty.INSTANCE) != 0) targetConfig.get(WorkersProperty.INSTANCE) else "std::thread::hardware_concurrency()"};
             |  bool fast{${targetConfig.get(FastProperty.INSTANCE)}};
             |  reactor::Duration lf_timeout{${if (targetConfig.isSet(TimeOutProperty.INSTANCE)) targetConfig.get(TimeOutProperty.INSTANCE).toCppCode() else "reactor::Duration::max()"}};
@@ -78,7 +78,7 @@ class CppRos2PackageGenerator(generator: CppGenerator, private val nodeName: Str
                 |
                 |ament_auto_add_library($S{LF_MAIN_TARGET} SHARED
                 |    src/$nodeName.cc
-            ${" |    "..sources.joinWithLn { "src/$it" }}
+            ${" |    "..sources.sorted().joinWithLn { "src/$it" }}
                 |)
                 |ament_target_dependencies($S{LF_MAIN_TARGET} ${dependencies.joinToString(" ")})
                 |target_include_directories($S{LF_MAIN_TARGET} PUBLIC
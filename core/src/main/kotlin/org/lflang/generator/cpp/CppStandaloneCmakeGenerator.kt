@@ -31,6 +31,7 @@ import org.lflang.joinWithLn
 import org.lflang.target.property.BuildTypeProperty
 import org.lflang.target.property.CmakeIncludeProperty
 import org.lflang.target.property.ExternalRuntimePathProperty
+import org.lflang.target.property.FastBuildProperty
 import org.lflang.target.property.RuntimeVersionProperty
 import org.lflang.toUnixString
 import java.nio.file.Path
@@ -69,6 +70,54 @@ class CppStandaloneCmakeGenerator(private val targetConfig: TargetConfig, privat
             |  endif()
             |endif()
             |
+            |# The RelWithLTO build type is the Release type plus interprocedural optimization
+            |# across the generated program and the reactor-cpp runtime library
+            |if(CMAKE_BUILD_TYPE STREQUAL "RelWithLTO")
+            |  set(CMAKE_BUILD_TYPE "Release")
+            |  include(CheckIPOSupported)
+            |  check_ipo_supported(RESULT LF_IPO_SUPPORTED OUTPUT LF_IPO_ERROR)
+            |  if(LF_IPO_SUPPORTED)
+            |    set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+            |  else()
+            |    message(WARNING "Not using link time optimization since it is not supported: $S{LF_IPO_ERROR}")
+            |  endif()
+            |endif()
+            |
+            |# Profile-guided optimization is a two-phase flow: configure with the ProfileGen build
+            |# type and run the program (or a benchmark) to produce profiles in LF_PGO_DIR, then
+            |# reconfigure with the ProfileUse build type to consume them.
+            |set(LF_PGO_DIR "$S{CMAKE_BINARY_DIR}/pgo-profiles" CACHE PATH "Directory where PGO profiles are written and read.")
+            |if(CMAKE_BUILD_TYPE STREQUAL "ProfileGen")
+            |  set(CMAKE_BUILD_TYPE "Release")
+            |
+            |  if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+            |    set(CMAKE_CXX_FLAGS "$S{CMAKE_CXX_FLAGS} -fprofile-generate=$S{LF_PGO_DIR}")
+            |    set(CMAKE_EXE_LINKER_FLAGS "$S{CMAKE_EXE_LINKER_FLAGS} -fprofile-generate=$S{LF_PGO_DIR}")
+            |    set(CMAKE_SHARED_LINKER_FLAGS "$S{CMAKE_SHARED_LINKER_FLAGS} -fprofile-generate=$S{LF_PGO_DIR}")
+            |  else()
+            |    message(WARNING "Not instrumenting for profile generation since the selected compiler does not support it")
+            |  endif()
+            |elseif(CMAKE_BUILD_TYPE STREQUAL "ProfileUse")
+            |  set(CMAKE_BUILD_TYPE "Release")
+            |
+            |  if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+            |    set(CMAKE_CXX_FLAGS "$S{CMAKE_CXX_FLAGS} -fprofile-use=$S{LF_PGO_DIR} -fprofile-correction")
+            |  elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+            |    # clang expects the raw profiles to be merged first, e.g.
+            |    # llvm-profdata merge -output=default.profdata $S{LF_PGO_DIR}/*.profraw
+            |    set(CMAKE_CXX_FLAGS "$S{CMAKE_CXX_FLAGS} -fprofile-use=$S{LF_PGO_DIR}/default.profdata")
+            |  else()
+            |    message(WARNING "Not using profiles since the selected compiler does not support profile-guided optimization")
+            |  endif()
+            |
+            |  # profile-guided builds benefit most when combined with cross-library inlining
+            |  include(CheckIPOSupported)
+            |  check_ipo_supported(RESULT LF_IPO_SUPPORTED OUTPUT LF_IPO_ERROR)
+            |  if(LF_IPO_SUPPORTED)
+            |    set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+            |  endif()
+            |endif()
+            |
             |# require C++ $CPP_VERSION
             |set(CMAKE_CXX_STANDARD $CPP_VERSION CACHE STRING "The C++ standard is cached for visibility in external tools." FORCE)
             |set(CMAKE_CXX_STANDARD_REQUIRED ON)
@@ -138,7 +187,32 @@ class CppStandaloneCmakeGenerator(private val targetConfig: TargetConfig, privat
         """.trimMargin()
     }
 
+    /**
+     * Generate build acceleration settings for the main target if the fast-build property is set.
+     *
+     * Precompiling the runtime's umbrella header avoids re-parsing it (and cxxopts) in every
+     * generated translation unit, and unity builds batch the generated sources into larger
+     * translation units. Both only affect compilation speed, not program behavior.
+     */
+    private fun generateFastBuildProperties(): String {
+        if (!targetConfig.get(FastBuildProperty.INSTANCE)) {
+            return ""
+        }
+        return """
+            |if(CMAKE_VERSION VERSION_GREATER_EQUAL "3.16")
+            |  target_precompile_headers($S{LF_MAIN_TARGET} PRIVATE <reactor-cpp/reactor-cpp.hh>)
+            |  set_target_properties($S{LF_MAIN_TARGET} PROPERTIES UNITY_BUILD ON UNITY_BUILD_BATCH_SIZE 8)
+            |else()
+            |  message(STATUS "fast-build requires CMake 3.16 or newer; compiling without precompiled headers")
+            |endif()
+        """.trimMargin()
+    }
+
     fun generateCmake(sources: List<Path>): String {
+        // Note that the source list is emitted in sorted order. This keeps the generated file
+        // byte-identical across runs, so that an unchanged CMakeLists.txt is not rewritten and
+        // does not trigger a CMake reconfigure.
+
         // Resolve path to the cmake include files if any was provided
         val includeFiles = targetConfig.get(CmakeIncludeProperty.INSTANCE)?.map { fileConfig.srcPath.resolve(it).toUnixString() }
 
@@ -160,7 +234,7 @@ class CppStandaloneCmakeGenerator(private val targetConfig: TargetConfig, privat
                 |set(LF_MAIN_TARGET ${fileConfig.name})
                 |
                 |add_executable($S{LF_MAIN_TARGET}
-            ${" |    "..sources.joinWithLn { it.toUnixString() }}
+            ${" |    "..sources.sorted().joinWithLn { it.toUnixString() }}
                 |)
                 |target_include_directories($S{LF_MAIN_TARGET} PUBLIC
                 |    "$S{LF_SRC_PKG_PATH}/src"
@@ -179,6 +253,8 @@ class CppStandaloneCmakeGenerator(private val targetConfig: TargetConfig, privat
                 |  target_compile_options($S{LF_MAIN_TARGET} PRIVATE -Wall -Wextra -pedantic)
                 |endif()
                 |
+            ${" |"..generateFastBuildProperties()}
+                |
                 |install(TARGETS $S{LF_MAIN_TARGET}
                 |        RUNTIME DESTINATION $S{CMAKE_INSTALL_BINDIR}
                 |        OPTIONAL
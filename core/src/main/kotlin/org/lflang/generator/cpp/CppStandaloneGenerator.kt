@@ -4,6 +4,7 @@ import org.lflang.generator.CodeMap
 import org.lflang.generator.LFGeneratorContext
 import org.lflang.generator.docker.DockerGenerator
 import org.lflang.target.property.BuildTypeProperty
+import org.lflang.target.property.StaticScheduleProperty
 import org.lflang.target.property.CompilerProperty
 import org.lflang.target.property.type.BuildTypeType.BuildType
 import org.lflang.toUnixString
@@ -44,6 +45,12 @@ class CppStandaloneGenerator(generator: CppGenerator) :
 
         FileUtil.writeToFile(mainCodeMap.generatedCode, srcGenPath.resolve(mainFile), true)
 
+        // generate the static schedule if requested
+        if (targetConfig.get(StaticScheduleProperty.INSTANCE)) {
+            val scheduleCode = CppStaticScheduleGenerator(mainReactor, messageReporter).generateCode()
+            FileUtil.writeToFile(scheduleCode, srcGenPath.resolve("static_schedule.hh"), true)
+        }
+
         // generate the cmake scripts
         val cmakeGenerator = CppStandaloneCmakeGenerator(targetConfig, generator.fileConfig)
         val srcGenRoot = fileConfig.srcGenBasePath
@@ -5,10 +5,14 @@ import org.lflang.generator.PrependOperator
 import org.lflang.inferredType
 import org.lflang.lf.Parameter
 import org.lflang.lf.Reactor
+import org.lflang.target.property.BenchmarkProperty
 import org.lflang.target.property.ExportDependencyGraphProperty
 import org.lflang.target.property.ExportToYamlProperty
 import org.lflang.target.property.FastProperty
+import org.lflang.target.property.MetricsProperty
+import org.lflang.target.property.StaticScheduleProperty
 import org.lflang.target.property.TimeOutProperty
+import org.lflang.target.property.TracingProperty
 import org.lflang.target.property.WorkersProperty
 import org.lflang.toUnixString
 
@@ -42,7 +46,10 @@ class CppStandaloneMainGenerator(
     private fun generateMainReactorInstantiation(): String =
             """auto main = std ::make_unique<${main.name}> ("${main.name}", &e, ${main.name}::Parameters{${main.parameters.joinToString(", ") { ".${it.name} = ${it.name}" }}});"""
 
-    fun generateCode() = with(PrependOperator) {
+    fun generateCode(): String =
+        if (targetConfig.get(BenchmarkProperty.INSTANCE)) generateBenchmarkCode() else generateStandardCode()
+
+    private fun generateStandardCode() = with(PrependOperator) {
         """
         ${" |"..fileComment(main.eResource())}
             |
@@ -59,6 +66,9 @@ class CppStandaloneMainGenerator(
             |#include "${fileConfig.getReactorHeaderPath(main).toUnixString()}"
             |
             |#include "time_parser.hh"
+            |${if (targetConfig.get(StaticScheduleProperty.INSTANCE)) """#include "static_schedule.hh"""" else ""}
+            |${if (targetConfig.get(TracingProperty.INSTANCE).isEnabled) """#include "lf_tracing.hh"""" else ""}
+            |${if (targetConfig.get(MetricsProperty.INSTANCE)) """#include "lf_metrics.hh"""" else ""}
             |
             |int main(int argc, char **argv) {
             |  cxxopts::Options options("${fileConfig.name}", "Reactor Program");
@@ -66,14 +76,20 @@ class CppStandaloneMainGenerator(
             |  unsigned workers = ${if (targetConfig.get(WorkersProperty.INSTANCE) != 0) targetConfig.get(WorkersProperty.INSTANCE) else "std::thread::hardware_concurrency()"};
             |  bool fast{${targetConfig.get(FastProperty.INSTANCE)}};
             |  reactor::Duration timeout = ${if (targetConfig.isSet(TimeOutProperty.INSTANCE)) targetConfig.get(TimeOutProperty.INSTANCE).toCppCode() else "reactor::Duration::max()"};
-            |  
-            |  // the timeout variable needs to be tested beyond fitting the Duration-type 
+            |  std::string pin_workers{};
+            |  int numa_node{-1};
+            |${if (targetConfig.get(MetricsProperty.INSTANCE)) "  unsigned metrics_port{0};" else ""}
+            |
+            |  // the timeout variable needs to be tested beyond fitting the Duration-type
             |  options
             |    .set_width(120)
             |    .add_options()
             |      ("w,workers", "the number of worker threads used by the scheduler", cxxopts::value<unsigned>(workers)->default_value(std::to_string(workers)), "'unsigned'")
             |      ("o,timeout", "Time after which the execution is aborted.", cxxopts::value<reactor::Duration>(timeout)->default_value(time_to_string(timeout)), "'FLOAT UNIT'")
             |      ("f,fast", "Allow logical time to run faster than physical time.", cxxopts::value<bool>(fast)->default_value("${targetConfig.get(FastProperty.INSTANCE)}"))
+            |      ("pin-workers", "Pin the worker threads to the given list of CPUs, e.g. '0-3,8'.", cxxopts::value<std::string>(pin_workers), "'CPULIST'")
+            |      ("numa-node", "Restrict memory allocation and, unless --pin-workers is given, worker placement to the given NUMA node.", cxxopts::value<int>(numa_node), "'int'")
+            |${if (targetConfig.get(MetricsProperty.INSTANCE)) """      ("metrics-port", "Serve runtime metrics in Prometheus format on the given TCP port.", cxxopts::value<unsigned>(metrics_port), "'unsigned'")""" else ""}
             |      ("help", "Print help");
             |      
         ${" |"..main.parameters.joinToString("\n\n") { generateParameterParser(it) }}
@@ -94,6 +110,13 @@ class CppStandaloneMainGenerator(
             |       return parse_error ? -1 : 0;
             |  }
             |
+            |  // apply CPU affinity and NUMA policy before the scheduler spawns its worker
+            |  // threads, so that they inherit the placement
+            |  lfutil::apply_worker_placement(pin_workers, numa_node);
+            |
+            |  // let program assembly use the same number of threads as the scheduler
+            |  lfutil::set_assembly_parallelism(workers);
+            |
             |  reactor::Environment e{workers, fast, timeout};
             |
             |  // instantiate the main reactor
@@ -103,10 +126,173 @@ class CppStandaloneMainGenerator(
             |  e.assemble();
         ${" |".. if (targetConfig.get(ExportDependencyGraphProperty.INSTANCE)) "e.export_dependency_graph(\"${main.name}.dot\");" else ""}
         ${" |".. if (targetConfig.get(ExportToYamlProperty.INSTANCE)) "e.dump_to_yaml(\"${main.name}.yaml\");" else ""}
+        ${" |".. if (targetConfig.get(StaticScheduleProperty.INSTANCE)) """reactor::log::Info() << "Using a precomputed schedule with " << lf_static_schedule::num_reactions << " reactions on " << lf_static_schedule::num_levels << " levels";""" else ""}
+        ${" |"..generateMetricsServerStartup()}
             |
             |  // start execution
             |  auto thread = e.startup();
             |  thread.join();
+        ${" |".. if (targetConfig.get(MetricsProperty.INSTANCE)) "metrics_server.stop();" else ""}
+        ${" |".. if (targetConfig.get(TracingProperty.INSTANCE).isEnabled) """lfutil::tracing::flush("${traceFileName()}");""" else ""}
+            |  return 0;
+            |}
+        """.trimMargin()
+    }
+
+    private fun generateMetricsServerStartup(): String =
+        if (targetConfig.get(MetricsProperty.INSTANCE))
+            """
+                |
+                |  // start serving metrics if requested on the command line
+                |  lfutil::metrics::MetricsServer metrics_server{};
+                |  if (metrics_port != 0 && !metrics_server.start(static_cast<unsigned short>(metrics_port))) {
+                |    reactor::log::Error() << "Failed to start the metrics server on port " << metrics_port;
+                |  }
+            """.trimMargin()
+        else ""
+
+    /** The file that reaction traces are flushed to at shutdown. */
+    private fun traceFileName(): String =
+        targetConfig.get(TracingProperty.INSTANCE).traceFileName ?: "${fileConfig.name}.trace.json"
+
+    /**
+     * Generate a benchmark harness instead of the regular main function.
+     *
+     * The harness constructs, assembles and executes the program repeatedly: first for a number of
+     * warmup iterations, then for the measured runs. Wall-clock execution times are reported as
+     * percentile statistics and optionally written to a JSON file.
+     */
+    private fun generateBenchmarkCode() = with(PrependOperator) {
+        """
+        ${" |"..fileComment(main.eResource())}
+            |
+            |#include <algorithm>
+            |#include <chrono>
+            |#include <fstream>
+            |#include <memory>
+            |#include <thread>
+            |#include <vector>
+            |
+            |#include "reactor-cpp/reactor-cpp.hh"
+            |
+            |using namespace std::chrono_literals;
+            |using namespace reactor::operators;
+            |
+            |
+            |#include "${fileConfig.getReactorHeaderPath(main).toUnixString()}"
+            |
+            |#include "time_parser.hh"
+            |
+            |int main(int argc, char **argv) {
+            |  cxxopts::Options options("${fileConfig.name}", "Reactor Benchmark");
+            |
+            |  unsigned workers = ${if (targetConfig.get(WorkersProperty.INSTANCE) != 0) targetConfig.get(WorkersProperty.INSTANCE) else "std::thread::hardware_concurrency()"};
+            |  bool fast{${targetConfig.get(FastProperty.INSTANCE)}};
+            |  reactor::Duration timeout = ${if (targetConfig.isSet(TimeOutProperty.INSTANCE)) targetConfig.get(TimeOutProperty.INSTANCE).toCppCode() else "reactor::Duration::max()"};
+            |  std::string pin_workers{};
+            |  int numa_node{-1};
+            |  unsigned warmup{2};
+            |  unsigned runs{10};
+            |  std::string json_file{};
+            |
+            |  options
+            |    .set_width(120)
+            |    .add_options()
+            |      ("w,workers", "the number of worker threads used by the scheduler", cxxopts::value<unsigned>(workers)->default_value(std::to_string(workers)), "'unsigned'")
+            |      ("o,timeout", "Time after which the execution is aborted.", cxxopts::value<reactor::Duration>(timeout)->default_value(time_to_string(timeout)), "'FLOAT UNIT'")
+            |      ("f,fast", "Allow logical time to run faster than physical time.", cxxopts::value<bool>(fast)->default_value("${targetConfig.get(FastProperty.INSTANCE)}"))
+            |      ("pin-workers", "Pin the worker threads to the given list of CPUs, e.g. '0-3,8'.", cxxopts::value<std::string>(pin_workers), "'CPULIST'")
+            |      ("numa-node", "Restrict memory allocation and, unless --pin-workers is given, worker placement to the given NUMA node.", cxxopts::value<int>(numa_node), "'int'")
+            |      ("warmup", "Number of unmeasured warmup iterations.", cxxopts::value<unsigned>(warmup)->default_value("2"), "'unsigned'")
+            |      ("r,runs", "Number of measured runs.", cxxopts::value<unsigned>(runs)->default_value("10"), "'unsigned'")
+            |      ("json", "File to write the benchmark results to in JSON format.", cxxopts::value<std::string>(json_file), "'PATH'")
+            |      ("help", "Print help");
+            |
+        ${" |"..main.parameters.joinToString("\n\n") { generateParameterParser(it) }}
+            |
+            |  cxxopts::ParseResult result{};
+            |  bool parse_error{false};
+            |  try {
+            |    result = options.parse(argc, argv);
+            |  } catch (const cxxopts::OptionException& e) {
+            |    reactor::log::Error() << e.what();
+            |    parse_error = true;
+            |  }
+            |
+            |  // if parameter --help was used or there was a parse error, print help
+            |  if (parse_error || result.count("help"))
+            |  {
+            |       std::cout << options.help({""});
+            |       return parse_error ? -1 : 0;
+            |  }
+            |
+            |  // the percentile computation below indexes into the measured durations
+            |  if (runs == 0) {
+            |    reactor::log::Error() << "--runs must be at least 1";
+            |    return -1;
+            |  }
+            |
+            |  // apply CPU affinity and NUMA policy before the scheduler spawns its worker
+            |  // threads, so that they inherit the placement
+            |  lfutil::apply_worker_placement(pin_workers, numa_node);
+            |
+            |  // let program assembly use the same number of threads as the scheduler
+            |  lfutil::set_assembly_parallelism(workers);
+            |
+            |  // construct, assemble and execute the program once, returning the wall-clock
+            |  // execution time in milliseconds
+            |  auto run_once = [&]() {
+            |    reactor::Environment e{workers, fast, timeout};
+            |    ${generateMainReactorInstantiation()}
+            |    e.assemble();
+            |    auto start = std::chrono::steady_clock::now();
+            |    auto thread = e.startup();
+            |    thread.join();
+            |    auto stop = std::chrono::steady_clock::now();
+            |    return std::chrono::duration<double, std::milli>(stop - start).count();
+            |  };
+            |
+            |  for (unsigned i{0}; i < warmup; i++) {
+            |    run_once();
+            |  }
+            |
+            |  std::vector<double> durations;
+            |  durations.reserve(runs);
+            |  for (unsigned i{0}; i < runs; i++) {
+            |    durations.push_back(run_once());
+            |  }
+            |  std::sort(durations.begin(), durations.end());
+            |
+            |  auto percentile = [&](double p) {
+            |    auto index = static_cast<std::size_t>(p / 100.0 * static_cast<double>(durations.size() - 1) + 0.5);
+            |    return durations[index];
+            |  };
+            |
+            |  std::cout << "benchmark: ${fileConfig.name}\n";
+            |  std::cout << "runs: " << runs << '\n';
+            |  std::cout << "min_ms: " << durations.front() << '\n';
+            |  std::cout << "median_ms: " << percentile(50.0) << '\n';
+            |  std::cout << "p90_ms: " << percentile(90.0) << '\n';
+            |  std::cout << "p99_ms: " << percentile(99.0) << '\n';
+            |  std::cout << "max_ms: " << durations.back() << '\n';
+            |
+            |  if (!json_file.empty()) {
+            |    std::ofstream json(json_file);
+            |    json << "{\n";
+            |    json << "  \"benchmark\": \"${fileConfig.name}\",\n";
+            |    json << "  \"runs\": " << runs << ",\n";
+            |    json << "  \"times_ms\": [";
+            |    for (std::size_t i{0}; i < durations.size(); i++) {
+            |      json << (i == 0 ? "" : ", ") << durations[i];
+            |    }
+            |    json << "],\n";
+            |    json << "  \"min_ms\": " << durations.front() << ",\n";
+            |    json << "  \"median_ms\": " << percentile(50.0) << ",\n";
+            |    json << "  \"p90_ms\": " << percentile(90.0) << ",\n";
+            |    json << "  \"p99_ms\": " << percentile(99.0) << ",\n";
+            |    json << "  \"max_ms\": " << durations.back() << "\n";
+            |    json << "}\n";
+            |  }
             |  return 0;
             |}
         """.trimMargin()
@@ -0,0 +1,73 @@
+package org.lflang.generator.cpp
+
+import org.lflang.MessageReporter
+import org.lflang.generator.PrependOperator
+import org.lflang.generator.ReactionInstance
+import org.lflang.generator.ReactorInstance
+import org.lflang.lf.Reactor
+
+/**
+ * A code generator that computes the reaction dependency graph at code generation time.
+ *
+ * With the `static-schedule` target property, the dependency analysis that the runtime would
+ * otherwise perform during assembly is done by the compiler: the full program is instantiated,
+ * reaction levels are assigned, and causality cycles are reported as compile errors. The result is
+ * emitted as compile-time data in `static_schedule.hh`.
+ */
+class CppStaticScheduleGenerator(
+    private val main: Reactor,
+    private val messageReporter: MessageReporter
+) {
+
+    /** Collect all reactions in the program, in depth-first instantiation order. */
+    private fun collectReactions(instance: ReactorInstance): List<ReactionInstance> =
+        instance.reactions + instance.children.flatMap { collectReactions(it) }
+
+    fun generateCode(): String {
+        val mainInstance = ReactorInstance(main, messageReporter)
+        val graph = mainInstance.assignLevels()
+        if (graph.nodeCount() != 0) {
+            messageReporter.nowhere()
+                .error("Cannot compute a static schedule because the program contains a causality cycle.")
+            return ""
+        }
+
+        val reactions = collectReactions(mainInstance)
+        // A reaction of a bank may occur at multiple levels; we record the deepest one.
+        val entries = reactions.map { Pair(it.fullName, it.levels.maxOrNull() ?: 0) }
+        val numLevels = (entries.maxOfOrNull { it.second } ?: -1) + 1
+
+        return with(PrependOperator) {
+            """
+            ${" |"..fileComment(main.eResource())}
+                |
+                |#pragma once
+                |
+                |#include <array>
+                |#include <cstddef>
+                |#include <string_view>
+                |
+                |/*
+                | * The reaction dependency graph of this program, computed at code generation time.
+                | * Each entry records a reaction and its level in the topologically sorted reaction
+                | * graph. The absence of causality cycles has already been verified by the compiler.
+                | */
+                |namespace lf_static_schedule {
+                |
+                |struct ReactionEntry {
+                |  std::string_view fqn;
+                |  std::size_t level;
+                |};
+                |
+                |constexpr std::size_t num_reactions = ${entries.size};
+                |constexpr std::size_t num_levels = $numLevels;
+                |
+                |constexpr std::array<ReactionEntry, ${entries.size}> reactions{{
+            ${" |  "..entries.joinToString(",\n") { """{"${it.first}", ${it.second}}""" }}
+                |}};
+                |
+                |} // namespace lf_static_schedule
+            """.trimMargin()
+        }
+    }
+}
@@ -28,7 +28,14 @@ import org.lflang.generator.orZero
 import org.lflang.lf.Reactor
 import org.lflang.lf.Timer
 
-/** A C++ code generator for timers */
+/**
+ * A C++ code generator for timers.
+ *
+ * Each declared timer becomes its own reactor::Timer. Coalescing timers with identical offset and
+ * period into references to a shared instance looks attractive for the event queue, but it breaks
+ * assembly: a reaction triggered by two such timers would register the same trigger twice, and the
+ * runtime reports all of them under the canonical timer's name.
+ */
 class CppTimerGenerator(private val reactor: Reactor) {
 
     private fun generateInitializer(timer: Timer): String {
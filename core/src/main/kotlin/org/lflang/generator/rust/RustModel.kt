@@ -728,6 +728,10 @@ val BuildType.cargoProfileName: String
         BuildType.RELEASE           -> "release"
         BuildType.REL_WITH_DEB_INFO -> "release-with-debug-info"
         BuildType.MIN_SIZE_REL      -> "release-with-min-size"
+        // the LTO and PGO build types are CMake specific and map to a plain release profile
+        BuildType.REL_WITH_LTO      -> "release"
+        BuildType.PROFILE_GEN       -> "release"
+        BuildType.PROFILE_USE       -> "release"
     }
 
 /** Just the constructor of [CargoDependencySpec], but allows using named arguments. */
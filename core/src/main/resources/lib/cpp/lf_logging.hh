@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026, TU Dresden.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "lfutil.hh"
+
+/// The maximum log level compiled into the program: 0 = error, 1 = warn, 2 = info, 3 = debug.
+/// Calls to a stripped level compile to nothing, so debug logging in hot reaction paths is free
+/// in release builds. Override with e.g. -DLF_LOG_LEVEL=3 in the compiler flags.
+#ifndef LF_LOG_LEVEL
+#define LF_LOG_LEVEL 2
+#endif
+
+/*
+ * Asynchronous logging for generated programs.
+ *
+ * reactor::log streams format eagerly and write to the sink from the calling thread, so logging in
+ * a high-rate reaction costs a syscall per record. lfutil::log keeps the same ostream style but
+ * formats into a thread-local buffer and hands the finished record to a background writer thread,
+ * which batches all pending records into a single write. Records never interleave, and the writer
+ * flushes everything still queued when the program exits.
+ */
+namespace lfutil::log {
+
+enum class Level { error = 0, warn = 1, info = 2, debug = 3 };
+
+constexpr Level max_level{static_cast<Level>(LF_LOG_LEVEL)};
+
+/// The background thread that owns the sink. Records arrive through a lock-free MpscStage; the
+/// mutex and condition variable are only used to park the writer while the stage is empty.
+class AsyncWriter {
+private:
+  MpscStage<std::string> stage;
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::atomic<bool> running{true};
+  std::thread thread;
+
+  AsyncWriter()
+      : thread([this]() { run(); }) {}
+
+  void write_pending() {
+    std::string batch;
+    stage.drain([&](std::string&& record) { batch += record; });
+    if (!batch.empty()) {
+      std::fwrite(batch.data(), 1, batch.size(), stderr);
+      std::fflush(stderr);
+    }
+  }
+
+  void run() {
+    while (running.load(std::memory_order_acquire)) {
+      {
+        std::unique_lock<std::mutex> lock{mutex};
+        cv.wait_for(lock, std::chrono::milliseconds(100));
+      }
+      write_pending();
+    }
+  }
+
+public:
+  static AsyncWriter& instance() {
+    static AsyncWriter writer{};
+    return writer;
+  }
+
+  ~AsyncWriter() {
+    running.store(false, std::memory_order_release);
+    cv.notify_one();
+    thread.join();
+    // flush whatever was enqueued after the writer's last pass
+    write_pending();
+  }
+
+  void enqueue(std::string&& record) {
+    if (stage.push(std::move(record))) {
+      // the stage was empty, so the writer may be parked; wake it
+      cv.notify_one();
+    }
+  }
+};
+
+/// An ostream-style log statement. When the level is stripped at compile time, all operations are
+/// empty inline functions and the statement compiles to nothing.
+template <Level level> class LogStream {
+private:
+  static constexpr bool enabled = static_cast<int>(level) <= static_cast<int>(max_level);
+  struct NoStream {};
+  std::conditional_t<enabled, std::ostringstream, NoStream> stream;
+
+  static constexpr const char* prefix() {
+    switch (level) {
+    case Level::error:
+      return "[ERROR] ";
+    case Level::warn:
+      return "[WARN]  ";
+    case Level::info:
+      return "[INFO]  ";
+    case Level::debug:
+      return "[DEBUG] ";
+    }
+    return "";
+  }
+
+public:
+  LogStream() {
+    if constexpr (enabled) {
+      stream << prefix();
+    }
+  }
+
+  LogStream(const LogStream&) = delete;
+  LogStream& operator=(const LogStream&) = delete;
+
+  template <class T> LogStream& operator<<(const T& value) {
+    if constexpr (enabled) {
+      stream << value;
+    }
+    return *this;
+  }
+
+  ~LogStream() {
+    if constexpr (enabled) {
+      stream << '\n';
+      AsyncWriter::instance().enqueue(std::move(stream).str());
+    }
+  }
+};
+
+using Error = LogStream<Level::error>;
+using Warn = LogStream<Level::warn>;
+using Info = LogStream<Level::info>;
+using Debug = LogStream<Level::debug>;
+
+} // namespace lfutil::log
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026, TU Dresden.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <reactor-cpp/reactor-cpp.hh>
+
+/*
+ * Runtime metrics support for generated programs.
+ *
+ * With the `metrics` target property enabled, the generator instruments each reaction body with a
+ * ScopedMeasure that updates per-reaction atomic counters and log-scale execution time histograms,
+ * and main() gains a --metrics-port option that serves the aggregated counters in Prometheus text
+ * format from a small stats thread. The hot path performs only relaxed atomic increments, so the
+ * instrumentation can stay enabled in production.
+ */
+namespace lfutil::metrics {
+
+/// Number of log2 histogram buckets; bucket i counts durations below 2^i microseconds.
+constexpr std::size_t num_buckets = 20;
+
+/// Counters collected for one reaction. All members are updated with relaxed atomics from
+/// whichever worker happens to execute the reaction.
+struct ReactionStats {
+  std::string name;
+  std::atomic<std::uint64_t> invocations{0};
+  std::atomic<std::uint64_t> total_ns{0};
+  std::array<std::atomic<std::uint64_t>, num_buckets> buckets{};
+
+  explicit ReactionStats(std::string_view name)
+      : name(name) {}
+
+  void record(std::int64_t duration_ns) {
+    invocations.fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(static_cast<std::uint64_t>(duration_ns), std::memory_order_relaxed);
+    auto micros = static_cast<std::uint64_t>(duration_ns) / 1000;
+    std::size_t bucket{0};
+    while (bucket < num_buckets - 1 && micros >= (std::uint64_t{1} << bucket)) {
+      bucket++;
+    }
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  }
+};
+
+/// Registry of all per-reaction counters and program-wide gauges, rendered on scrape.
+class Registry {
+private:
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ReactionStats>> reactions;
+  std::atomic<std::uint64_t> deadline_misses{0};
+  std::atomic<std::uint64_t> deadline_near_misses{0};
+  std::atomic<std::int64_t> lag_ns{0};
+  std::chrono::steady_clock::time_point start_time{std::chrono::steady_clock::now()};
+
+  Registry() = default;
+
+public:
+  static Registry& instance() {
+    static Registry registry{};
+    return registry;
+  }
+
+  /// Obtain the counters for one reaction. Called once per reaction site through a function-local
+  /// static, so the lock is only taken on the first invocation.
+  ReactionStats& reaction(std::string_view name) {
+    std::lock_guard<std::mutex> lock{mutex};
+    reactions.push_back(std::make_unique<ReactionStats>(name));
+    return *reactions.back();
+  }
+
+  void count_deadline_miss() { deadline_misses.fetch_add(1, std::memory_order_relaxed); }
+
+  /// Record that a reaction with a deadline started with less than a tenth of its deadline left.
+  void count_deadline_near_miss() { deadline_near_misses.fetch_add(1, std::memory_order_relaxed); }
+
+  /// Record the physical-vs-logical lag observed at the start of a reaction.
+  void record_lag(std::int64_t nanoseconds) { lag_ns.store(nanoseconds, std::memory_order_relaxed); }
+
+  /// Render all counters in the Prometheus text exposition format.
+  std::string render() {
+    std::lock_guard<std::mutex> lock{mutex};
+    std::ostringstream out;
+    auto uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time);
+    out << "# TYPE lf_uptime_seconds counter\n";
+    out << "lf_uptime_seconds " << uptime.count() << '\n';
+    out << "# TYPE lf_deadline_misses_total counter\n";
+    out << "lf_deadline_misses_total " << deadline_misses.load(std::memory_order_relaxed) << '\n';
+    out << "# TYPE lf_deadline_near_misses_total counter\n";
+    out << "lf_deadline_near_misses_total " << deadline_near_misses.load(std::memory_order_relaxed) << '\n';
+    out << "# TYPE lf_lag_seconds gauge\n";
+    out << "lf_lag_seconds " << static_cast<double>(lag_ns.load(std::memory_order_relaxed)) / 1e9 << '\n';
+    out << "# TYPE lf_reaction_duration_seconds histogram\n";
+    for (const auto& stats : reactions) {
+      std::uint64_t cumulative{0};
+      for (std::size_t bucket{0}; bucket < num_buckets; bucket++) {
+        cumulative += stats->buckets[bucket].load(std::memory_order_relaxed);
+        out << "lf_reaction_duration_seconds_bucket{reaction=\"" << stats->name << "\",le=\"";
+        if (bucket == num_buckets - 1) {
+          out << "+Inf";
+        } else {
+          out << static_cast<double>(std::uint64_t{1} << bucket) / 1e6;
+        }
+        out << "\"} " << cumulative << '\n';
+      }
+      out << "lf_reaction_duration_seconds_sum{reaction=\"" << stats->name << "\"} "
+          << static_cast<double>(stats->total_ns.load(std::memory_order_relaxed)) / 1e9 << '\n';
+      out << "lf_reaction_duration_seconds_count{reaction=\"" << stats->name << "\"} "
+          << stats->invocations.load(std::memory_order_relaxed) << '\n';
+    }
+    return out.str();
+  }
+};
+
+/// RAII measurement wrapping one reaction body execution.
+class ScopedMeasure {
+private:
+  ReactionStats& stats;
+  std::chrono::steady_clock::time_point start;
+
+public:
+  ScopedMeasure(ReactionStats& stats, const reactor::Tag& tag)
+      : stats(stats)
+      , start(std::chrono::steady_clock::now()) {
+    auto lag = reactor::get_physical_time() - tag.time_point();
+    Registry::instance().record_lag(std::chrono::duration_cast<std::chrono::nanoseconds>(lag).count());
+  }
+
+  ScopedMeasure(const ScopedMeasure&) = delete;
+  ScopedMeasure& operator=(const ScopedMeasure&) = delete;
+
+  ~ScopedMeasure() {
+    auto duration = std::chrono::steady_clock::now() - start;
+    stats.record(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+  }
+};
+
+/// A minimal HTTP endpoint serving the registry in Prometheus format.
+class MetricsServer {
+private:
+  std::thread thread;
+  std::atomic<bool> running{false};
+  int listen_fd{-1};
+
+public:
+  /// Start serving on the given TCP port. Returns false if the socket could not be opened or the
+  /// platform has no socket API.
+  bool start(unsigned short port) {
+#if defined(__unix__) || defined(__APPLE__)
+    listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+      return false;
+    }
+    int reuse{1};
+    ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listen_fd, 4) < 0) {
+      ::close(listen_fd);
+      listen_fd = -1;
+      return false;
+    }
+    running.store(true);
+    thread = std::thread([this]() {
+      while (running.load()) {
+        int client = ::accept(listen_fd, nullptr, nullptr);
+        if (client < 0) {
+          continue;
+        }
+        auto body = Registry::instance().render();
+        std::string response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                               std::to_string(body.size()) + "\r\n\r\n" + body;
+        std::size_t written{0};
+        while (written < response.size()) {
+          auto result = ::write(client, response.data() + written, response.size() - written);
+          if (result <= 0) {
+            break;
+          }
+          written += static_cast<std::size_t>(result);
+        }
+        ::close(client);
+      }
+    });
+    return true;
+#else
+    (void)port;
+    return false;
+#endif
+  }
+
+  void stop() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (listen_fd >= 0) {
+      running.store(false);
+      // closing the socket unblocks the accept call in the server thread
+      ::shutdown(listen_fd, SHUT_RDWR);
+      ::close(listen_fd);
+      listen_fd = -1;
+    }
+    if (thread.joinable()) {
+      thread.join();
+    }
+#endif
+  }
+
+  ~MetricsServer() { stop(); }
+};
+
+} // namespace lfutil::metrics
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026, TU Dresden.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/*
+ * Pooled allocation for the values travelling along the event path.
+ *
+ * Message payloads allocated per tag and freed when the tag completes turn malloc/free into the
+ * hottest functions of a bursty program. The pools here keep that memory: a per-worker,
+ * size-classed free list recycles individual payloads without synchronization, and a TagArena
+ * hands out storage for everything belonging to one tag and releases it in a single drain() when
+ * the tag completes. Both only touch the global allocator to grow.
+ *
+ * The runtime's internal event objects are created inside its scheduler and cannot be redirected
+ * from here; these pools cover the payload allocations that generated code and reaction bodies
+ * perform on that path.
+ */
+namespace lfutil::pool {
+
+/// A size-classed free-list allocator. Blocks come in power-of-two classes from 16 bytes to 4 KiB;
+/// larger requests fall through to the global allocator.
+class SizeClassPool {
+private:
+  static constexpr std::size_t smallest_class_shift{4}; // 16 bytes
+  static constexpr std::size_t num_classes{9};          // 16 ... 4096 bytes
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  std::array<FreeBlock*, num_classes> free_lists{};
+  std::vector<std::unique_ptr<std::byte[]>> slabs;
+
+  static std::size_t class_of(std::size_t size) {
+    std::size_t index{0};
+    while ((std::size_t{1} << (index + smallest_class_shift)) < size) {
+      index++;
+    }
+    return index;
+  }
+
+  void grow(std::size_t class_index) {
+    auto block_size = std::size_t{1} << (class_index + smallest_class_shift);
+    // grow by one slab of 16 blocks, threaded onto the free list
+    constexpr std::size_t blocks_per_slab{16};
+    slabs.push_back(std::make_unique<std::byte[]>(block_size * blocks_per_slab));
+    auto* slab = slabs.back().get();
+    for (std::size_t block{0}; block < blocks_per_slab; block++) {
+      auto* header = reinterpret_cast<FreeBlock*>(slab + block * block_size);
+      header->next = free_lists[class_index];
+      free_lists[class_index] = header;
+    }
+  }
+
+public:
+  SizeClassPool() = default;
+  SizeClassPool(const SizeClassPool&) = delete;
+  SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+  void* allocate(std::size_t size) {
+    if (size > (std::size_t{1} << (num_classes - 1 + smallest_class_shift))) {
+      return ::operator new(size);
+    }
+    auto class_index = class_of(size);
+    if (free_lists[class_index] == nullptr) {
+      grow(class_index);
+    }
+    auto* block = free_lists[class_index];
+    free_lists[class_index] = block->next;
+    return block;
+  }
+
+  void deallocate(void* block, std::size_t size) {
+    if (size > (std::size_t{1} << (num_classes - 1 + smallest_class_shift))) {
+      ::operator delete(block);
+      return;
+    }
+    auto class_index = class_of(size);
+    auto* header = static_cast<FreeBlock*>(block);
+    header->next = free_lists[class_index];
+    free_lists[class_index] = header;
+  }
+};
+
+/// The calling worker's pool. Thread-local, so allocation and release never synchronize as long
+/// as a payload dies on the worker that created it.
+inline SizeClassPool& local_pool() {
+  thread_local SizeClassPool pool{};
+  return pool;
+}
+
+/// A std-compatible allocator drawing from the calling worker's pool. Plugging it into the
+/// containers of a message type moves their element storage off the global allocator:
+///
+///     struct Frame {
+///       std::vector<float, lfutil::pool::PoolAllocator<float>> samples;
+///     };
+template <class T> class PoolAllocator {
+public:
+  using value_type = T;
+
+  PoolAllocator() = default;
+  template <class U> PoolAllocator(const PoolAllocator<U>&) {}
+
+  T* allocate(std::size_t count) { return static_cast<T*>(local_pool().allocate(count * sizeof(T))); }
+  void deallocate(T* block, std::size_t count) { local_pool().deallocate(block, count * sizeof(T)); }
+
+  bool operator==(const PoolAllocator&) const { return true; }
+  bool operator!=(const PoolAllocator&) const { return false; }
+};
+
+/**
+ * A bump arena for allocations that all die when the current tag completes.
+ *
+ * Everything allocated since the last drain() is released by that one call, which only resets an
+ * offset and keeps the arena's blocks for the next tag — steady-state execution performs no heap
+ * operations at all. The intended use is one arena per reactor, drained by the reaction that
+ * finishes the tag's work.
+ */
+class TagArena {
+private:
+  static constexpr std::size_t block_size{64 * 1024};
+
+  std::vector<std::unique_ptr<std::byte[]>> blocks;
+  std::size_t current_block{0};
+  std::size_t offset{0};
+
+public:
+  /// Allocate storage with the given alignment. Valid until the next drain().
+  void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+    assert(size <= block_size);
+    offset = (offset + alignment - 1) & ~(alignment - 1);
+    if (blocks.empty() || offset + size > block_size) {
+      if (current_block + 1 >= blocks.size()) {
+        blocks.push_back(std::make_unique<std::byte[]>(block_size));
+      }
+      if (!blocks.empty() && offset != 0) {
+        current_block++;
+      }
+      offset = 0;
+    }
+    void* result = blocks[current_block].get() + offset;
+    offset += size;
+    return result;
+  }
+
+  /// Construct an object in the arena. The object must be trivially destructible or be destroyed
+  /// by the caller before the next drain().
+  template <class T, class... Args> T* create(Args&&... args) {
+    return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  /// Release everything allocated since the last drain, keeping the storage for the next tag.
+  void drain() {
+    current_block = 0;
+    offset = 0;
+  }
+};
+
+} // namespace lfutil::pool
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026, TU Dresden.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <utility>
+
+#include <rclcpp/rclcpp.hpp>
+
+/*
+ * Zero-copy helpers for the ROS2 platform (`ros2: true`).
+ *
+ * Only include this header from programs built as a ROS2 node; it requires rclcpp.
+ */
+namespace lfutil::ros2 {
+
+/**
+ * Publish a message constructed directly in a middleware-loaned buffer.
+ *
+ * Copy-converting a port value into a ROS message and handing it to publish() moves large
+ * payloads twice: once into the message and once into the middleware. When the middleware can
+ * loan messages (e.g. zero-copy shared-memory transports), this helper borrows the target buffer
+ * first and lets the `fill` callback construct the payload in place, so the reaction writes the
+ * data exactly once:
+ *
+ *     reaction(frame) {=
+ *       lfutil::ros2::publish_loaned(*publisher, [&](sensor_msgs::msg::Image& msg) {
+ *         encode(*frame.get(), msg);
+ *       });
+ *     =}
+ *
+ * If the middleware cannot loan messages for this publisher, the helper transparently falls back
+ * to a stack-constructed message and a regular publish.
+ */
+template <class Msg, class Fill> void publish_loaned(rclcpp::Publisher<Msg>& publisher, Fill&& fill) {
+  if (publisher.can_loan_messages()) {
+    auto loaned = publisher.borrow_loaned_message();
+    std::forward<Fill>(fill)(loaned.get());
+    publisher.publish(std::move(loaned));
+  } else {
+    Msg message{};
+    std::forward<Fill>(fill)(message);
+    publisher.publish(message);
+  }
+}
+
+} // namespace lfutil::ros2
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026, TU Dresden.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Serialization of port values for cross-process connections.
+ *
+ * Trivially copyable port types use their flat in-memory layout as the wire layout, so encoding
+ * and decoding is a single memcpy into the target buffer. For types with indirections (such as
+ * std::string members) the program provides an encode/decode pair next to the type definition,
+ * found via argument dependent lookup:
+ *
+ *     inline void lf_encode(const Hello& hello, lfutil::serial::Writer& writer) {
+ *       writer.write_string(hello.name);
+ *       writer.write_trivial(hello.value);
+ *     }
+ *     inline void lf_decode(lfutil::serial::Reader& reader, Hello& hello) {
+ *       hello.name = reader.read_string();
+ *       hello.value = reader.read_trivial<int>();
+ *     }
+ *
+ * Encoded records travel between processes through a SharedMemoryRing, a lock-free SPSC byte ring
+ * that can be placed in any mapping shared by the two processes.
+ */
+namespace lfutil::serial {
+
+/// Appends the length-prefixed wire encoding of values to a byte buffer.
+class Writer {
+private:
+  std::vector<std::byte>& buffer;
+
+public:
+  explicit Writer(std::vector<std::byte>& buffer)
+      : buffer(buffer) {}
+
+  void write_bytes(const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const std::byte*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+  }
+
+  template <class T> void write_trivial(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    write_bytes(&value, sizeof(T));
+  }
+
+  void write_string(std::string_view value) {
+    write_trivial(static_cast<std::uint32_t>(value.size()));
+    write_bytes(value.data(), value.size());
+  }
+};
+
+/// Reads values back out of a wire encoding produced by a Writer.
+class Reader {
+private:
+  std::span<const std::byte> data;
+  std::size_t pos{0};
+
+public:
+  explicit Reader(std::span<const std::byte> data)
+      : data(data) {}
+
+  void read_bytes(void* destination, std::size_t size) {
+    assert(pos + size <= data.size());
+    std::memcpy(destination, data.data() + pos, size);
+    pos += size;
+  }
+
+  template <class T> T read_trivial() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value;
+    read_bytes(&value, sizeof(T));
+    return value;
+  }
+
+  std::string read_string() {
+    auto size = read_trivial<std::uint32_t>();
+    std::string value(size, '\0');
+    read_bytes(value.data(), size);
+    return value;
+  }
+};
+
+/// Append the wire encoding of a value to the buffer. Trivially copyable types are copied flat;
+/// everything else dispatches to the type's lf_encode.
+template <class T> void encode(const T& value, std::vector<std::byte>& buffer) {
+  Writer writer{buffer};
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    writer.write_trivial(value);
+  } else {
+    lf_encode(value, writer);
+  }
+}
+
+/// Reconstruct a value from its wire encoding.
+template <class T> T decode(std::span<const std::byte> bytes) {
+  Reader reader{bytes};
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    return reader.read_trivial<T>();
+  } else {
+    T value{};
+    lf_decode(reader, value);
+    return value;
+  }
+}
+
+/**
+ * A lock-free SPSC ring of length-prefixed byte records, placed in caller-provided memory.
+ *
+ * The ring's entire state lives inside the memory region it is attached to, so a region obtained
+ * from shm_open/mmap (or any other mapping visible to both processes) carries complete records
+ * from one process to another without further copies or locks. One process attaches with
+ * initialize = true, the peer with initialize = false.
+ */
+class SharedMemoryRing {
+private:
+  alignas(64) std::atomic<std::uint64_t> head{0}; // consumer cursor, counts bytes
+  alignas(64) std::atomic<std::uint64_t> tail{0}; // producer cursor, counts bytes
+  alignas(64) std::uint64_t capacity{0};
+  // the payload area follows the ring state in the attached memory region
+
+  std::byte* payload() { return reinterpret_cast<std::byte*>(this) + sizeof(SharedMemoryRing); }
+
+  void copy_in(std::uint64_t position, const void* data, std::uint64_t size) {
+    auto offset = position % capacity;
+    auto first_chunk = std::min(size, capacity - offset);
+    std::memcpy(payload() + offset, data, first_chunk);
+    std::memcpy(payload(), static_cast<const std::byte*>(data) + first_chunk, size - first_chunk);
+  }
+
+  void copy_out(std::uint64_t position, void* destination, std::uint64_t size) {
+    auto offset = position % capacity;
+    auto first_chunk = std::min(size, capacity - offset);
+    std::memcpy(destination, payload() + offset, first_chunk);
+    std::memcpy(static_cast<std::byte*>(destination) + first_chunk, payload(), size - first_chunk);
+  }
+
+public:
+  /// Attach a ring to the given memory region. The region must be at least
+  /// sizeof(SharedMemoryRing) plus the desired payload capacity.
+  static SharedMemoryRing* attach(void* memory, std::size_t region_size, bool initialize) {
+    assert(region_size > sizeof(SharedMemoryRing));
+    if (initialize) {
+      auto* ring = ::new (memory) SharedMemoryRing{};
+      ring->capacity = region_size - sizeof(SharedMemoryRing);
+      return ring;
+    }
+    return static_cast<SharedMemoryRing*>(memory);
+  }
+
+  /// Append one record. Returns false without blocking if the ring lacks space.
+  bool push(std::span<const std::byte> record) {
+    auto size = static_cast<std::uint64_t>(record.size());
+    auto current_tail = tail.load(std::memory_order_relaxed);
+    auto used = current_tail - head.load(std::memory_order_acquire);
+    if (used + sizeof(std::uint32_t) + size > capacity) {
+      return false;
+    }
+    auto length = static_cast<std::uint32_t>(size);
+    copy_in(current_tail, &length, sizeof(length));
+    copy_in(current_tail + sizeof(length), record.data(), size);
+    tail.store(current_tail + sizeof(length) + size, std::memory_order_release);
+    return true;
+  }
+
+  /// Remove the oldest record into `record`. Returns false without blocking if the ring is empty.
+  bool pop(std::vector<std::byte>& record) {
+    auto current_head = head.load(std::memory_order_relaxed);
+    if (current_head == tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    std::uint32_t length{0};
+    copy_out(current_head, &length, sizeof(length));
+    record.resize(length);
+    copy_out(current_head + sizeof(length), record.data(), length);
+    head.store(current_head + sizeof(length) + length, std::memory_order_release);
+    return true;
+  }
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+/// Map a named POSIX shared memory region of the given size, creating it if necessary. Returns
+/// nullptr on failure. The same name and size attach cooperating processes to the same region.
+inline void* map_shared_region(const std::string& name, std::size_t size) {
+  int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+  if (fd < 0) {
+    return nullptr;
+  }
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    ::close(fd);
+    return nullptr;
+  }
+  void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  return memory == MAP_FAILED ? nullptr : memory;
+}
+#endif
+
+} // namespace lfutil::serial
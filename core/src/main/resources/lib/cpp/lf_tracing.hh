@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026, TU Dresden.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include <reactor-cpp/reactor-cpp.hh>
+
+/*
+ * Hot-path tracing support for generated reaction bodies.
+ *
+ * When the `tracing` target property is enabled, the generator wraps each reaction body and
+ * deadline handler in a ScopedTrace. Records are written to per-worker ring buffers without any
+ * synchronization on the hot path; the only locking happens once per thread at registration and
+ * once at shutdown when flush() merges all buffers into a Chrome/Perfetto compatible JSON trace.
+ */
+namespace lfutil::tracing {
+
+struct TraceRecord {
+  std::string_view name;
+  std::int64_t logical_time_ns;
+  std::uint64_t microstep;
+  std::int64_t start_ns;
+  std::int64_t stop_ns;
+};
+
+/// A fixed-capacity ring buffer of trace records owned by one worker thread.
+class RingBuffer {
+private:
+  static constexpr std::size_t capacity = 1 << 16;
+  std::vector<TraceRecord> records{capacity};
+  std::atomic<std::size_t> head{0};
+
+public:
+  void push(const TraceRecord& record) {
+    auto index = head.fetch_add(1, std::memory_order_relaxed);
+    records[index % capacity] = record;
+  }
+
+  /// Visit all valid records. Only safe to call when the owning thread no longer writes.
+  template <class Visitor> void visit(Visitor&& visitor) const {
+    auto count = std::min(head.load(std::memory_order_acquire), capacity);
+    for (std::size_t i{0}; i < count; i++) {
+      visitor(records[i]);
+    }
+  }
+};
+
+/// Registry of all per-worker ring buffers. The registry owns the buffers: worker threads exit
+/// before flush() runs, so buffer lifetime must not be tied to the threads that fill them.
+class Registry {
+private:
+  std::mutex mutex;
+  std::vector<std::pair<std::size_t, std::unique_ptr<RingBuffer>>> buffers;
+
+  Registry() = default;
+
+public:
+  static Registry& instance() {
+    static Registry registry{};
+    return registry;
+  }
+
+  /// Create a buffer for the calling worker. The buffer stays alive in the registry until the
+  /// program ends, well past the owning thread's exit.
+  RingBuffer* create_buffer() {
+    std::lock_guard<std::mutex> lock{mutex};
+    auto worker_id = buffers.size();
+    buffers.emplace_back(worker_id, std::make_unique<RingBuffer>());
+    return buffers.back().second.get();
+  }
+
+  /// Write all collected records as a Chrome/Perfetto trace-event JSON file.
+  void flush(const std::string& file_name) {
+    std::lock_guard<std::mutex> lock{mutex};
+    std::ofstream out{file_name};
+    out << "{\"traceEvents\":[";
+    bool first{true};
+    for (const auto& [worker_id, buffer] : buffers) {
+      buffer->visit([&](const TraceRecord& record) {
+        if (!first) {
+          out << ',';
+        }
+        first = false;
+        out << "{\"name\":\"" << record.name << "\",\"cat\":\"reaction\",\"ph\":\"X\""
+            << ",\"ts\":" << static_cast<double>(record.start_ns) / 1e3
+            << ",\"dur\":" << static_cast<double>(record.stop_ns - record.start_ns) / 1e3
+            << ",\"pid\":0,\"tid\":" << worker_id << ",\"args\":{\"logical_time_ns\":" << record.logical_time_ns
+            << ",\"microstep\":" << record.microstep << "}}";
+      });
+    }
+    out << "]}\n";
+  }
+};
+
+/// The calling worker's ring buffer, created in the registry on first use.
+inline RingBuffer& local_buffer() {
+  thread_local RingBuffer* buffer = Registry::instance().create_buffer();
+  return *buffer;
+}
+
+/// Flush all per-worker buffers to the given file. Intended to be called once after execution.
+inline void flush(const std::string& file_name) { Registry::instance().flush(file_name); }
+
+/// RAII trace point wrapping one reaction body or deadline handler execution.
+class ScopedTrace {
+private:
+  TraceRecord record;
+
+  static std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+public:
+  ScopedTrace(std::string_view name, const reactor::Tag& tag) {
+    record.name = name;
+    record.logical_time_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(tag.time_point().time_since_epoch()).count();
+    record.microstep = tag.micro_step();
+    record.start_ns = now();
+  }
+
+  ScopedTrace(const ScopedTrace&) = delete;
+  ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+  ~ScopedTrace() {
+    record.stop_ns = now();
+    local_buffer().push(record);
+  }
+};
+
+} // namespace lfutil::tracing
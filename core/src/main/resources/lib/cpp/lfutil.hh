@@ -24,11 +24,401 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include <reactor-cpp/logging.hh>
 #include <reactor-cpp/reactor-cpp.hh>
 
 namespace lfutil {
 
+/**
+ * A monotonic arena that owns the storage of all members of a reactor bank.
+ *
+ * With the `memory-layout: arena` target property, the generated code reserves one arena per bank
+ * and constructs all bank members in it back-to-back, so that iterating over the bank during
+ * reaction execution touches contiguous memory instead of chasing scattered heap pointers. The
+ * arena only releases its storage after all objects constructed in it have been destroyed.
+ */
+class ReactorArena {
+private:
+  std::unique_ptr<std::byte[]> storage{nullptr};
+  std::size_t capacity{0};
+  std::size_t offset{0};
+
+public:
+  /// Reserve storage for all objects to be constructed in this arena. May only be called once.
+  void reserve(std::size_t bytes) {
+    assert(storage == nullptr);
+    storage = std::make_unique<std::byte[]>(bytes);
+    capacity = bytes;
+  }
+
+  /// Construct an object of type T in the arena. The returned pointer owns the object but not its
+  /// storage, which stays alive until the arena is destroyed.
+  template <class T, class... Args> auto create(Args&&... args) {
+    // round up to the alignment of T
+    offset = (offset + alignof(T) - 1) & ~(alignof(T) - 1);
+    assert(offset + sizeof(T) <= capacity);
+    T* object = ::new (static_cast<void*>(storage.get() + offset)) T(std::forward<Args>(args)...);
+    offset += sizeof(T);
+    auto deleter = [](T* obj) { obj->~T(); };
+    return std::unique_ptr<T, void (*)(T*)>(object, deleter);
+  }
+};
+
+/// Owning pointer to an object whose storage is managed by a ReactorArena.
+template <class T> using arena_ptr = std::unique_ptr<T, void (*)(T*)>;
+
+/**
+ * A fixed-capacity pool recycling objects through a free list, with no allocation after setup.
+ *
+ * The reactor topology is fixed at assembly, so a connection-per-client gateway cannot grow or
+ * shrink a bank at runtime — and provisioning a worst-case bank keeps every cold member alive as
+ * an event source. The supported pattern is to keep the dynamic population as plain state inside
+ * one gateway reactor: sessions are acquired from an ObjectPool on accept (a free-list pop and a
+ * placement-new, never a heap allocation) and released on close, while per-session timeouts go
+ * through a TimerWheel instead of per-member timers. Cold capacity then costs exactly one
+ * uninitialized pool slot and no event sources:
+ *
+ *     state sessions: {= lfutil::ObjectPool<Session> =}
+ *
+ *     reaction(startup) {= sessions.reserve(max_clients); =}
+ *     reaction(accept) {=
+ *       if (auto* session = sessions.acquire(client_fd())) { ... }
+ *     =}
+ *     reaction(close) {= sessions.release(session); =}
+ */
+template <class T> class ObjectPool {
+private:
+  std::unique_ptr<std::byte[]> storage{nullptr};
+  T* base{nullptr};
+  std::vector<std::uint32_t> free_slots;
+  std::vector<bool> live;
+  std::size_t capacity_{0};
+
+  T* slot(std::size_t index) { return base + index; }
+
+public:
+  ObjectPool() = default;
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+
+  ~ObjectPool() {
+    for (std::size_t index{0}; index < capacity_; index++) {
+      if (live[index]) {
+        slot(index)->~T();
+      }
+    }
+  }
+
+  /// Allocate storage for the given number of objects. May only be called once.
+  void reserve(std::size_t capacity) {
+    assert(storage == nullptr);
+    storage = std::make_unique<std::byte[]>(capacity * sizeof(T) + alignof(T));
+    // round the slab base up to the alignment of T
+    auto address = reinterpret_cast<std::uintptr_t>(storage.get());
+    base = reinterpret_cast<T*>((address + alignof(T) - 1) & ~static_cast<std::uintptr_t>(alignof(T) - 1));
+    live.assign(capacity, false);
+    free_slots.reserve(capacity);
+    // popping from the back hands out low slots first
+    for (std::size_t index{capacity}; index > 0; index--) {
+      free_slots.push_back(static_cast<std::uint32_t>(index - 1));
+    }
+    capacity_ = capacity;
+  }
+
+  std::size_t capacity() const { return capacity_; }
+  std::size_t in_use() const { return capacity_ - free_slots.size(); }
+
+  /// Construct an object in a free slot, or return nullptr if the pool is exhausted.
+  template <class... Args> T* acquire(Args&&... args) {
+    if (free_slots.empty()) {
+      return nullptr;
+    }
+    auto index = free_slots.back();
+    free_slots.pop_back();
+    T* object = ::new (static_cast<void*>(slot(index))) T(std::forward<Args>(args)...);
+    live[index] = true;
+    return object;
+  }
+
+  /// Destroy an object acquired from this pool and return its slot to the free list.
+  void release(T* object) {
+    auto index = static_cast<std::size_t>(object - slot(0));
+    assert(index < capacity_ && live[index]);
+    object->~T();
+    live[index] = false;
+    free_slots.push_back(static_cast<std::uint32_t>(index));
+  }
+};
+
+/**
+ * A non-owning, random access view over the members of a reactor bank.
+ *
+ * Instead of materializing a vector of member views per reaction, a BankView constructs the
+ * per-member view on access. It supports the same indexing and iteration patterns as the
+ * std::vector of views that it replaces.
+ */
+template <class View, class BankPtr> class BankView {
+private:
+  const std::vector<BankPtr>* bank;
+
+public:
+  explicit BankView(const std::vector<BankPtr>& bank)
+      : bank(&bank) {}
+
+  auto size() const { return bank->size(); }
+  bool empty() const { return bank->empty(); }
+  View operator[](std::size_t index) const { return View((*bank)[index].get()); }
+
+  class iterator {
+  private:
+    const std::vector<BankPtr>* bank{nullptr};
+    std::size_t index{0};
+    // cache of the most recently accessed view, so that dereferencing can return an lvalue
+    mutable std::optional<View> view{std::nullopt};
+
+  public:
+    using value_type = View;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::input_iterator_tag;
+
+    iterator() = default;
+    iterator(const std::vector<BankPtr>& bank, std::size_t index)
+        : bank(&bank)
+        , index(index) {}
+
+    View& operator*() const {
+      view.emplace((*bank)[index].get());
+      return *view;
+    }
+    iterator& operator++() {
+      index++;
+      return *this;
+    }
+    iterator operator++(int) {
+      auto result = *this;
+      index++;
+      return result;
+    }
+    bool operator==(const iterator& other) const { return bank == other.bank && index == other.index; }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+  };
+
+  iterator begin() const { return iterator(*bank, 0); }
+  iterator end() const { return iterator(*bank, bank->size()); }
+};
+
+/// Parse a Linux style CPU list such as "0-3,8,10-11" into the individual CPU numbers.
+///
+/// A malformed or out-of-range entry invalidates the whole list: a warning is logged and an empty
+/// list is returned, so the caller falls back to the default placement instead of pinning the
+/// workers to an unintended set of CPUs.
+inline std::vector<int> parse_cpu_list(const std::string& cpu_list) {
+#if defined(__linux__)
+  constexpr int max_cpu{CPU_SETSIZE - 1}; // CPU_SET in apply_worker_placement must stay in range
+#else
+  constexpr int max_cpu{1023};
+#endif
+  auto parse_cpu = [](std::string_view token, int& cpu) {
+    const auto* last = token.data() + token.size();
+    auto [end, errc] = std::from_chars(token.data(), last, cpu);
+    return errc == std::errc{} && end == last && cpu >= 0 && cpu <= max_cpu;
+  };
+  std::vector<int> cpus;
+  std::string_view list{cpu_list};
+  std::size_t pos{0};
+  while (pos < list.size()) {
+    auto comma = list.find(',', pos);
+    auto entry = list.substr(pos, comma == std::string_view::npos ? std::string_view::npos : comma - pos);
+    auto dash = entry.find('-');
+    int from{0};
+    int to{0};
+    bool valid = parse_cpu(entry.substr(0, dash), from);
+    if (valid) {
+      valid = dash == std::string_view::npos ? (to = from, true) : parse_cpu(entry.substr(dash + 1), to);
+    }
+    if (!valid || to < from) {
+      reactor::log::Warn() << "Invalid CPU list entry \"" << entry << "\"; ignoring the CPU list";
+      return {};
+    }
+    for (int cpu = from; cpu <= to; cpu++) {
+      cpus.push_back(cpu);
+    }
+    if (comma == std::string_view::npos) {
+      break;
+    }
+    pos = comma + 1;
+  }
+  return cpus;
+}
+
+/// Retrieve the CPUs belonging to the given NUMA node, or an empty list if the topology is unknown.
+inline std::vector<int> cpus_of_numa_node(int node) {
+#if defined(__linux__)
+  std::ifstream in{"/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+  std::string cpu_list;
+  if (in && std::getline(in, cpu_list)) {
+    return parse_cpu_list(cpu_list);
+  }
+#else
+  (void)node;
+#endif
+  return {};
+}
+
+/**
+ * Apply the placement requested via the --pin-workers and --numa-node command line options.
+ *
+ * This pins the calling thread to the given CPU list (or, if only a NUMA node is given, to the
+ * CPUs of that node) and sets the preferred NUMA node for memory allocation. It must be called
+ * before the environment spawns its worker threads, which then inherit both the affinity mask and
+ * the memory policy. On platforms without affinity APIs this logs a warning and does nothing.
+ */
+inline void apply_worker_placement(const std::string& cpu_list, int numa_node) {
+#if defined(__linux__)
+  auto cpus = cpu_list.empty() ? std::vector<int>{} : parse_cpu_list(cpu_list);
+  if (cpus.empty() && numa_node >= 0) {
+    cpus = cpus_of_numa_node(numa_node);
+  }
+  if (!cpus.empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (auto cpu : cpus) {
+      CPU_SET(cpu, &cpu_set);
+    }
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+      reactor::log::Warn() << "Failed to set worker CPU affinity: " << std::strerror(errno);
+    }
+  }
+  if (numa_node >= 0) {
+#if defined(SYS_set_mempolicy)
+    constexpr int mpol_preferred{1}; // MPOL_PREFERRED from <numaif.h>, avoiding a libnuma dependency
+    unsigned long node_mask = 1UL << numa_node;
+    if (syscall(SYS_set_mempolicy, mpol_preferred, &node_mask, sizeof(node_mask) * 8) != 0) {
+      reactor::log::Warn() << "Failed to bind memory allocation to NUMA node " << numa_node << ": "
+                           << std::strerror(errno);
+    }
+#else
+    reactor::log::Warn() << "NUMA memory binding is not supported on this platform; ignoring --numa-node";
+#endif
+  }
+#else
+  if (!cpu_list.empty() || numa_node >= 0) {
+    reactor::log::Warn() << "Worker placement is not supported on this platform; "
+                         << "ignoring --pin-workers and --numa-node";
+  }
+#endif
+}
+
+/**
+ * Formats "<base>_<index>" bank member names into one reused buffer.
+ *
+ * The runtime's entity constructors take the name as a const std::string& and keep their own
+ * copy, so the copy itself cannot be avoided from generated code. What can be avoided are the
+ * temporaries: building each member name with operator+ and std::to_string costs two further heap
+ * allocations per member during assembly. An InstanceNames instance appends the digits directly
+ * into a single buffer that is reused for every member of the bank.
+ */
+class InstanceNames {
+private:
+  std::string buffer;
+  std::size_t base_length;
+
+public:
+  explicit InstanceNames(std::string_view base)
+      : buffer(base) {
+    buffer += '_';
+    base_length = buffer.size();
+  }
+
+  /// Format the name of the member with the given index. The returned reference stays valid until
+  /// the next call.
+  const std::string& of(std::size_t index) {
+    buffer.resize(base_length);
+    char digits[20];
+    auto result = std::to_chars(digits, digits + sizeof(digits), index);
+    buffer.append(digits, result.ptr);
+    return buffer;
+  }
+};
+
+/// The number of threads used for parallel program assembly. Defaults to 1 (serial assembly) and
+/// is set from the parsed --workers option by the generated main() before the main reactor is
+/// instantiated.
+inline unsigned assembly_parallelism{1};
+
+inline void set_assembly_parallelism(unsigned workers) {
+  assembly_parallelism = workers > 0 ? workers : std::thread::hardware_concurrency();
+}
+
+/**
+ * Run `body(i)` for all i in [0, count), spread across the assembly workers.
+ *
+ * This is used by the generated constructors of large enclave banks: members with private
+ * environments do not touch any shared runtime state during construction, so they can be
+ * instantiated concurrently. Work is handed out in small chunks claimed from a shared counter
+ * rather than as fixed per-thread partitions, so when iterations are skewed (one heavy member
+ * among many light ones) the remaining chunks flow to whichever workers are idle. The calling
+ * thread participates, small iteration counts fall back to a serial loop, and the function only
+ * returns once all iterations have completed.
+ */
+template <class Body> void parallel_for(std::size_t count, Body&& body) {
+  std::size_t num_threads = std::min<std::size_t>(assembly_parallelism, count / 2);
+  if (num_threads <= 1) {
+    for (std::size_t i{0}; i < count; i++) {
+      body(i);
+    }
+    return;
+  }
+  constexpr std::size_t chunk_size{8};
+  std::atomic<std::size_t> next{0};
+  auto worker = [&body, &next, count]() {
+    while (true) {
+      auto begin = next.fetch_add(chunk_size, std::memory_order_relaxed);
+      if (begin >= count) {
+        break;
+      }
+      auto end = std::min(count, begin + chunk_size);
+      for (std::size_t i{begin}; i < end; i++) {
+        body(i);
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (std::size_t thread_idx{1}; thread_idx < num_threads; thread_idx++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
 template <class T> void after_delay(reactor::Action<T>* action, const reactor::Port<T>* port) {
   if constexpr (std::is_void<T>::value) {
     action->schedule();
@@ -37,6 +427,455 @@ template <class T> void after_delay(reactor::Action<T>* action, const reactor::P
   }
 }
 
+/**
+ * Schedule a burst of values as one event on an action carrying a batch of samples.
+ *
+ * Every schedule() call synchronizes with the scheduler's event queue. Reactors that ingest bursts
+ * of external samples should declare their (physical) action with a std::vector element type and
+ * use this overload: the whole run [first, last) is moved into a single event at a single tag, so
+ * the queue is synchronized once per burst instead of once per sample. The triggered reaction sees
+ * the full batch in the action's value.
+ */
+template <class T, class InputIt>
+void schedule_batch(reactor::Action<std::vector<T>>* action, InputIt first, InputIt last) {
+  action->schedule(std::vector<T>(std::make_move_iterator(first), std::make_move_iterator(last)));
+}
+
+/**
+ * Schedule a run of values as individual events, one per sample.
+ *
+ * This fallback for scalar actions keeps the one-event-per-sample semantics and only amortizes the
+ * call overhead. It is intended for physical actions, where each sample is stamped with its own
+ * tag; on a logical action all samples would be scheduled at the same tag and replace each other.
+ */
+template <class T, class InputIt> void schedule_batch(reactor::Action<T>* action, InputIt first, InputIt last) {
+  for (auto it = first; it != last; ++it) {
+    action->schedule(std::move(*it));
+  }
+}
+
+/**
+ * A preallocated ring buffer carrying the in-flight values of a delayed stream.
+ *
+ * Forwarding a steady high-rate stream through a delayed connection allocates and frees storage
+ * for every in-flight message. An EventRing bounds that traffic: it is sized once from the delay
+ * and the expected message spacing, and values are then pushed and popped in FIFO order without
+ * touching the heap. Since all events of one delayed stream become ready in the order they were
+ * pushed, a reactor implementing a fused delay only needs this FIFO plus a value-less logical
+ * action as the trigger:
+ *
+ *     state ring: {= lfutil::EventRing<T> =}
+ *     logical action act
+ *
+ *     reaction(startup) {= ring.reserve(lfutil::EventRing<T>::capacity_for(delay, period)); =}
+ *     reaction(in) -> act {= ring.push(std::move(*in.get())); act.schedule(delay); =}
+ *     reaction(act) -> out {= out.set(ring.pop()); =}
+ *
+ * The ring grows like a vector if the observed rate exceeds the reserved capacity, so sizing is a
+ * performance hint, not a correctness requirement.
+ */
+template <class T> class EventRing {
+private:
+  std::vector<T> slots;
+  std::size_t head{0}; // index of the oldest value
+  std::size_t count{0};
+
+public:
+  /// Return the number of slots needed to hold all in-flight values of a stream with the given
+  /// delay and minimal message spacing.
+  static constexpr std::size_t capacity_for(reactor::Duration delay, reactor::Duration min_spacing) {
+    if (min_spacing <= reactor::Duration::zero()) {
+      return 1;
+    }
+    return static_cast<std::size_t>(delay / min_spacing) + 2;
+  }
+
+  /// Preallocate storage for the given number of in-flight values.
+  void reserve(std::size_t capacity) {
+    if (capacity > slots.size()) {
+      resize(capacity);
+    }
+  }
+
+  std::size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  void push(T&& value) {
+    if (count == slots.size()) {
+      resize(slots.empty() ? 8 : 2 * slots.size());
+    }
+    slots[(head + count) % slots.size()] = std::move(value);
+    count++;
+  }
+
+  /// Remove and return the oldest value. Must not be called on an empty ring.
+  T pop() {
+    assert(count > 0);
+    T value = std::move(slots[head]);
+    head = (head + 1) % slots.size();
+    count--;
+    return value;
+  }
+
+private:
+  void resize(std::size_t capacity) {
+    std::vector<T> grown(capacity);
+    for (std::size_t i{0}; i < count; i++) {
+      grown[i] = std::move(slots[(head + i) % slots.size()]);
+    }
+    slots = std::move(grown);
+    head = 0;
+  }
+};
+
+/**
+ * A hierarchical timer wheel tracking many armed deadlines in one structure.
+ *
+ * A reactor that supervises thousands of application-level timeouts (per-session deadlines, lease
+ * expirations) should not schedule one action per timeout. A TimerWheel keeps all armed deadlines
+ * in a fixed hierarchy of slot rings, so arming is O(1) and one advance() call per wakeup expires
+ * everything that is due. Together with a single logical action, the pattern is:
+ *
+ *     state wheel: {= lfutil::TimerWheel<SessionId> =}
+ *     logical action check
+ *
+ *     reaction(request) -> check {=
+ *       wheel.schedule(session, get_logical_time() + timeout);
+ *       check.schedule(*wheel.next_deadline() - get_logical_time());
+ *     =}
+ *
+ *     reaction(check) -> check {=
+ *       wheel.advance(get_logical_time(), [&](SessionId&& session) { expire(session); });
+ *       if (auto next = wheel.next_deadline()) {
+ *         check.schedule(*next - get_logical_time());
+ *       }
+ *     =}
+ *
+ * Near-misses of reaction deadlines are a separate concern and are counted by the metrics
+ * instrumentation (see lf_metrics.hh).
+ */
+template <class T> class TimerWheel {
+private:
+  static constexpr std::size_t num_levels{4};
+  static constexpr std::size_t slots_per_level{64};
+
+  struct Entry {
+    T value;
+    reactor::TimePoint deadline;
+  };
+
+  reactor::Duration resolution;
+  reactor::TimePoint start;
+  std::uint64_t current_tick{0};
+  std::size_t count{0};
+  std::array<std::array<std::vector<Entry>, slots_per_level>, num_levels> wheel;
+
+  std::uint64_t tick_of(reactor::TimePoint time) const {
+    return time <= start ? 0 : static_cast<std::uint64_t>((time - start) / resolution);
+  }
+
+  void insert(Entry&& entry) {
+    auto tick = std::max(tick_of(entry.deadline), current_tick);
+    auto delta = tick - current_tick;
+    std::size_t level{0};
+    std::uint64_t ticks_per_slot{1};
+    while (level < num_levels - 1 && delta >= ticks_per_slot * slots_per_level) {
+      ticks_per_slot *= slots_per_level;
+      level++;
+    }
+    wheel[level][(tick / ticks_per_slot) % slots_per_level].push_back(std::move(entry));
+  }
+
+public:
+  /// Create a wheel whose innermost level has one slot per `resolution`, anchored at `start`.
+  /// Deadlines more than resolution * 64^3 in the future saturate into the outermost level.
+  TimerWheel(reactor::Duration resolution, reactor::TimePoint start)
+      : resolution(resolution)
+      , start(start) {}
+
+  std::size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  /// Arm a deadline. Deadlines in the past expire on the next advance().
+  void schedule(T&& value, reactor::TimePoint deadline) {
+    insert(Entry{std::move(value), deadline});
+    count++;
+  }
+
+  /// Expire all deadlines up to and including `now`, passing their values to the consumer.
+  template <class Consumer> void advance(reactor::TimePoint now, Consumer&& consumer) {
+    auto target = tick_of(now);
+    while (current_tick <= target) {
+      auto& slot = wheel[0][current_tick % slots_per_level];
+      for (auto& entry : slot) {
+        consumer(std::move(entry.value));
+        count--;
+      }
+      slot.clear();
+      current_tick++;
+      // on a slot-ring wraparound, pull the next outer slot down into the finer levels
+      std::uint64_t ticks_per_slot{slots_per_level};
+      for (std::size_t level{1}; level < num_levels && current_tick % ticks_per_slot == 0; level++) {
+        auto& outer = wheel[level][(current_tick / ticks_per_slot) % slots_per_level];
+        for (auto& entry : outer) {
+          insert(std::move(entry));
+        }
+        outer.clear();
+        ticks_per_slot *= slots_per_level;
+      }
+    }
+  }
+
+  /// The earliest armed deadline, if any.
+  std::optional<reactor::TimePoint> next_deadline() const {
+    std::optional<reactor::TimePoint> earliest{std::nullopt};
+    for (const auto& level : wheel) {
+      for (const auto& slot : level) {
+        for (const auto& entry : slot) {
+          if (!earliest.has_value() || entry.deadline < *earliest) {
+            earliest = entry.deadline;
+          }
+        }
+      }
+    }
+    return earliest;
+  }
+};
+
+/**
+ * A contiguous struct-of-arrays snapshot of a multiport for vectorized access.
+ *
+ * Multiports store their values inside discrete port objects, so a fan-in reduction over a wide
+ * multiport performs one scattered load per channel. For trivially copyable value types, a
+ * MultiportView gathers all present values into one contiguous array with a parallel presence
+ * bitmask in a single pass over the ports. Reductions then run over values(), which the compiler
+ * can vectorize:
+ *
+ *     reaction(in) {=
+ *       lfutil::MultiportView<double> view{in};
+ *       double sum = 0.0;
+ *       for (double value : view.values()) {
+ *         sum += value;
+ *       }
+ *     =}
+ */
+template <class T> class MultiportView {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MultiportView is only intended for trivially copyable value types");
+
+private:
+  std::vector<T> values_;
+  std::vector<std::uint64_t> present_;
+  std::size_t width_;
+
+public:
+  template <class Multiport>
+  explicit MultiportView(const Multiport& multiport)
+      : width_(multiport.size()) {
+    values_.reserve(width_);
+    present_.assign((width_ + 63) / 64, 0);
+    std::size_t channel{0};
+    for (const auto& port : multiport) {
+      if (port.is_present()) {
+        present_[channel / 64] |= std::uint64_t{1} << (channel % 64);
+        values_.push_back(*port.get());
+      }
+      channel++;
+    }
+  }
+
+  /// The total number of channels of the underlying multiport.
+  std::size_t width() const { return width_; }
+  /// The number of channels that are present at the current tag.
+  std::size_t size() const { return values_.size(); }
+  bool empty() const { return values_.empty(); }
+  /// All present values, densely packed in channel order.
+  std::span<const T> values() const { return {values_.data(), values_.size()}; }
+  /// Whether the given channel was present when the view was constructed.
+  bool is_present(std::size_t channel) const { return (present_[channel / 64] >> (channel % 64)) & 1; }
+};
+
+/**
+ * A lock-free multi-producer single-consumer staging queue for physical actions.
+ *
+ * Physical actions are the bridge from external I/O threads into the reactor program, but every
+ * schedule() call synchronizes with the scheduler's event queue. At high producer rates this mutex
+ * becomes the bottleneck. An MpscStage moves the contention off that mutex: producer threads
+ * enqueue values with a single CAS, and only the producer that finds the stage empty schedules the
+ * associated physical action (the "doorbell"). The reaction triggered by the doorbell then drains
+ * the whole stage without locking:
+ *
+ *     state stage: {= lfutil::MpscStage<Sample> =}
+ *     physical action doorbell
+ *
+ *     // on an external thread:
+ *     if (stage.push(std::move(sample))) {
+ *       doorbell.schedule();
+ *     }
+ *
+ *     reaction(doorbell) {=
+ *       stage.drain([&](Sample&& sample) { process(sample); });
+ *     =}
+ *
+ * This turns one event-queue synchronization per sample into one per burst, while preserving the
+ * per-producer FIFO order of the drained values.
+ */
+template <class T> class MpscStage {
+private:
+  struct Node {
+    T value;
+    Node* next;
+  };
+
+  std::atomic<Node*> head{nullptr};
+
+public:
+  MpscStage() = default;
+  MpscStage(const MpscStage&) = delete;
+  MpscStage& operator=(const MpscStage&) = delete;
+
+  ~MpscStage() {
+    drain([](T&&) {});
+  }
+
+  /// Enqueue a value from any thread. Returns true if the stage was empty, in which case the
+  /// caller must ring the doorbell by scheduling the associated physical action.
+  bool push(T&& value) {
+    Node* node = new Node{std::move(value), nullptr};
+    Node* old_head = head.load(std::memory_order_relaxed);
+    do {
+      node->next = old_head;
+    } while (!head.compare_exchange_weak(old_head, node, std::memory_order_release, std::memory_order_relaxed));
+    return old_head == nullptr;
+  }
+
+  /// Remove all staged values and pass them to the consumer in the order they were pushed. Only
+  /// safe to call from one thread at a time, which in the intended pattern is the reaction
+  /// triggered by the doorbell action. Returns the number of drained values.
+  template <class Consumer> std::size_t drain(Consumer&& consumer) {
+    Node* node = head.exchange(nullptr, std::memory_order_acquire);
+    // the stage is a LIFO list; reverse it to obtain FIFO order
+    Node* reversed = nullptr;
+    while (node != nullptr) {
+      Node* next = node->next;
+      node->next = reversed;
+      reversed = node;
+      node = next;
+    }
+    std::size_t count{0};
+    while (reversed != nullptr) {
+      Node* next = reversed->next;
+      consumer(std::move(reversed->value));
+      delete reversed;
+      reversed = next;
+      count++;
+    }
+    return count;
+  }
+};
+
+/**
+ * A bounded lock-free single-producer single-consumer channel.
+ *
+ * Enclaves decouple a fast control loop from slow I/O, but values crossing the enclave boundary
+ * still synchronize through the receiving scheduler. When the fast side must never block on the
+ * slow side, an SpscChannel provides the wait-free fallback: the producer enclave pushes into a
+ * fixed ring and the consumer enclave drains it at its own pace, typically from a polling timer or
+ * an MpscStage-style doorbell:
+ *
+ *     // shared between the two enclaves, e.g. as a global in a public preamble
+ *     lfutil::SpscChannel<Frame> channel{256};
+ *
+ *     // in the fast enclave:
+ *     if (!channel.try_push(std::move(frame))) {
+ *       // the slow side is behind; drop or overwrite, but never block
+ *     }
+ *
+ *     // in the slow enclave:
+ *     reaction(poll) {=
+ *       channel.drain([&](Frame&& frame) { process(frame); });
+ *     =}
+ *
+ * The two cursors live on separate cache lines, and each side refreshes its copy of the opposing
+ * cursor only when the ring appears full or empty. This batches the cross-enclave handshake: a
+ * burst of n messages causes one cache-line transfer instead of n.
+ */
+template <class T> class SpscChannel {
+private:
+  std::vector<T> slots;
+  std::size_t mask;
+  alignas(64) std::atomic<std::size_t> head{0}; // consumer cursor
+  alignas(64) std::atomic<std::size_t> tail{0}; // producer cursor
+  alignas(64) std::size_t cached_head{0};       // producer's last view of the consumer cursor
+  alignas(64) std::size_t cached_tail{0};       // consumer's last view of the producer cursor
+
+  static constexpr std::size_t round_up_to_power_of_two(std::size_t capacity) {
+    std::size_t rounded{1};
+    while (rounded < capacity) {
+      rounded *= 2;
+    }
+    return rounded;
+  }
+
+public:
+  /// Create a channel holding at least the given number of in-flight values.
+  explicit SpscChannel(std::size_t capacity)
+      : slots(round_up_to_power_of_two(capacity))
+      , mask(slots.size() - 1) {}
+
+  SpscChannel(const SpscChannel&) = delete;
+  SpscChannel& operator=(const SpscChannel&) = delete;
+
+  std::size_t capacity() const { return slots.size(); }
+
+  /// Enqueue a value. Only safe to call from one producer thread. Returns false without blocking
+  /// if the channel is full.
+  bool try_push(T&& value) {
+    auto current_tail = tail.load(std::memory_order_relaxed);
+    if (current_tail - cached_head == slots.size()) {
+      cached_head = head.load(std::memory_order_acquire);
+      if (current_tail - cached_head == slots.size()) {
+        return false;
+      }
+    }
+    slots[current_tail & mask] = std::move(value);
+    tail.store(current_tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Dequeue the oldest value into `value`. Only safe to call from one consumer thread. Returns
+  /// false without blocking if the channel is empty.
+  bool try_pop(T& value) {
+    auto current_head = head.load(std::memory_order_relaxed);
+    if (current_head == cached_tail) {
+      cached_tail = tail.load(std::memory_order_acquire);
+      if (current_head == cached_tail) {
+        return false;
+      }
+    }
+    value = std::move(slots[current_head & mask]);
+    head.store(current_head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Remove all currently visible values and pass them to the consumer in FIFO order. Only safe
+  /// to call from the consumer thread. Returns the number of drained values.
+  template <class Consumer> std::size_t drain(Consumer&& consumer) {
+    auto current_head = head.load(std::memory_order_relaxed);
+    auto current_tail = tail.load(std::memory_order_acquire);
+    std::size_t count{0};
+    while (current_head != current_tail) {
+      consumer(std::move(slots[current_head & mask]));
+      current_head++;
+      count++;
+    }
+    // publish the consumer cursor once for the whole batch
+    head.store(current_head, std::memory_order_release);
+    cached_tail = current_tail;
+    return count;
+  }
+};
+
 template <class T> void after_forward(const reactor::Action<T>* action, reactor::Port<T>* port) {
   if constexpr (std::is_void<T>::value) {
     port->set();
@@ -45,6 +884,48 @@ template <class T> void after_forward(const reactor::Action<T>* action, reactor:
   }
 }
 
+/**
+ * Construct a port's value directly in its shared storage.
+ *
+ * port.set(value) constructs the value on the reaction stack and then moves it into the storage
+ * that is shared with downstream readers. For large message structs the extra move is measurable;
+ * emplace forwards the constructor arguments into the shared storage instead:
+ *
+ *     lfutil::emplace(out, "Earth", 42);
+ */
+template <class Port, class... Args> void emplace(Port& port, Args&&... args) {
+  port.set(reactor::make_mutable_value<typename Port::value_type>(std::forward<Args>(args)...));
+}
+
+/**
+ * Default-construct a port's value in its shared storage and let `init` fill it in place.
+ *
+ * This is the counterpart to emplace() for values that are built up incrementally rather than in
+ * one constructor call:
+ *
+ *     lfutil::set_inplace(out, [&](auto& msg) { msg.name = "Earth"; msg.value = 42; });
+ */
+template <class Port, class Init> void set_inplace(Port& port, Init&& init) {
+  auto value = reactor::make_mutable_value<typename Port::value_type>();
+  std::forward<Init>(init)(*value);
+  port.set(std::move(value));
+}
+
+/**
+ * Amend an upstream value and forward it downstream.
+ *
+ * The amendment operates on a mutable copy of the input value, since the runtime's value pointers
+ * do not expose whether this reactor is the sole reader; a true zero-copy borrow would need
+ * runtime support. The copy is still made directly in the shared storage of the outgoing value,
+ * avoiding a second move on set.
+ */
+template <class InPort, class OutPort, class Amend>
+void amend_and_forward(const InPort& in, OutPort& out, Amend&& amend) {
+  auto value = in.get().get_mutable_copy();
+  std::forward<Amend>(amend)(*value);
+  out.set(std::move(value));
+}
+
 class LFScope {
 private:
   reactor::Reactor* reactor;
@@ -63,39 +944,41 @@ public:
   void request_stop() const { return environment()->sync_shutdown(); }
 };
 
-template <class PortPtr>
+template <class PortPtr, class Connect>
 void bind_multiple_ports(std::vector<PortPtr>& left_ports, std::vector<PortPtr>& right_ports, bool repeat_left,
-                         std::function<void(PortPtr, PortPtr)> connect) {
-  if (repeat_left) {
-    auto l_size = left_ports.size();
-    auto r_size = right_ports.size();
+                         Connect&& connect) {
+  auto l_size = left_ports.size();
+  auto r_size = right_ports.size();
+
+  // In repeat mode the left ports are iterated as often as needed to serve all right ports. Instead
+  // of materializing the repeated port list, we simply index the left ports modulo their number.
+  auto effective_l_size = l_size;
+  if (repeat_left && l_size > 0) {
     // divide and round up
     auto repetitions = r_size / l_size + (r_size % l_size != 0);
-    // repeat repetitions-1 times
-    left_ports.reserve(repetitions * l_size);
-    for (std::size_t i{1}; i < repetitions; i++) {
-      std::copy_n(left_ports.begin(), l_size, std::back_inserter(left_ports));
-    }
+    effective_l_size = repetitions * l_size;
   }
 
-  auto left_it = left_ports.begin();
-  auto right_it = right_ports.begin();
-
-  if (left_ports.size() < right_ports.size()) {
+  if (effective_l_size < r_size) {
     reactor::log::Warn() << "There are more right ports than left ports. "
                          << "Not all ports will be connected!";
-  } else if (left_ports.size() > right_ports.size()) {
+  } else if (effective_l_size > r_size) {
     reactor::log::Warn() << "There are more left ports than right ports. "
                          << "Not all ports will be connected!";
   }
 
-  while (left_it != left_ports.end() && right_it != right_ports.end()) {
-    auto left = *left_it;
-    auto right = *right_it;
-    connect(left, right);
-    left_it++;
-    right_it++;
+  auto count = std::min(effective_l_size, r_size);
+  for (std::size_t i{0}; i < count; i++) {
+    connect(left_ports[i % l_size], right_ports[i]);
   }
 }
 
+template <class PortPtr>
+void bind_multiple_ports(std::vector<PortPtr>& left_ports, std::vector<PortPtr>& right_ports, bool repeat_left,
+                         std::function<void(PortPtr, PortPtr)> connect) {
+  // explicitly select the generic overload to avoid the type erasure of std::function
+  bind_multiple_ports<PortPtr, const std::function<void(PortPtr, PortPtr)>&>(left_ports, right_ports, repeat_left,
+                                                                             connect);
+}
+
 } // namespace lfutil
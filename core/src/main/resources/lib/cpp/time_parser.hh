@@ -31,15 +31,168 @@ std::stringstream& operator>>(std::stringstream& in, reactor::Duration& dur);
 #include "CLI/cxxopts.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
-#include <regex>
 #include <string>
+#include <string_view>
 
 bool iequals(const std::string& a, const std::string& b) {
   return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](char a, char b) { return tolower(a) == tolower(b); });
 }
 
+namespace lfutil {
+
+/**
+ * Minimal stand-in for std::expected<reactor::Duration, std::string>, which is only available
+ * with C++23.
+ */
+class DurationParseResult {
+private:
+  reactor::Duration duration{};
+  std::string message{};
+  bool ok{false};
+
+  DurationParseResult() = default;
+
+public:
+  static DurationParseResult success(reactor::Duration duration) {
+    DurationParseResult result{};
+    result.duration = duration;
+    result.ok = true;
+    return result;
+  }
+
+  static DurationParseResult failure(std::string message) {
+    DurationParseResult result{};
+    result.message = std::move(message);
+    return result;
+  }
+
+  explicit operator bool() const { return ok; }
+  reactor::Duration value() const { return duration; }
+  const std::string& error() const { return message; }
+};
+
+/// One entry of the compile-time unit table: all spellings of a unit map to a factor in nanoseconds.
+struct TimeUnitEntry {
+  std::string_view unit;
+  double nanoseconds;
+};
+
+constexpr std::array<TimeUnitEntry, 28> time_units{{{"nsec", 1.0},
+                                                    {"nsecs", 1.0},
+                                                    {"ns", 1.0},
+                                                    {"usec", 1e3},
+                                                    {"usecs", 1e3},
+                                                    {"us", 1e3},
+                                                    {"msec", 1e6},
+                                                    {"msecs", 1e6},
+                                                    {"ms", 1e6},
+                                                    {"sec", 1e9},
+                                                    {"secs", 1e9},
+                                                    {"second", 1e9},
+                                                    {"seconds", 1e9},
+                                                    {"s", 1e9},
+                                                    {"min", 60e9},
+                                                    {"mins", 60e9},
+                                                    {"minute", 60e9},
+                                                    {"minutes", 60e9},
+                                                    {"m", 60e9},
+                                                    {"hour", 3600e9},
+                                                    {"hours", 3600e9},
+                                                    {"h", 3600e9},
+                                                    {"day", 86400e9},
+                                                    {"days", 86400e9},
+                                                    {"d", 86400e9},
+                                                    {"week", 604800e9},
+                                                    {"weeks", 604800e9},
+                                                    {"w", 604800e9}}};
+
+/**
+ * Read a floating point value from the front of `text` into `value`.
+ *
+ * Returns the number of characters consumed, or zero if no value could be read. Uses the
+ * std::from_chars overload for double where the standard library provides it; libc++ (and thus
+ * macOS) does not, so there we fall back to std::strtod on a stack copy of the input, which is
+ * still allocation-free.
+ */
+inline std::size_t read_double(std::string_view text, double& value) {
+#if defined(__cpp_lib_to_chars)
+  auto [end, errc] = std::from_chars(text.data(), text.data() + text.size(), value);
+  return errc == std::errc{} ? static_cast<std::size_t>(end - text.data()) : 0;
+#else
+  // std::strtod requires a null-terminated string; a time value easily fits the stack buffer
+  std::array<char, 64> buffer{};
+  auto length = std::min(text.size(), buffer.size() - 1);
+  std::copy_n(text.data(), length, buffer.data());
+  char* end{nullptr};
+  errno = 0;
+  value = std::strtod(buffer.data(), &end);
+  if (end == buffer.data() || errno == ERANGE) {
+    return 0;
+  }
+  return static_cast<std::size_t>(end - buffer.data());
+#endif
+}
+
+/**
+ * Parse a time string of the form "FLOAT UNIT" (or "forever") into a reactor::Duration.
+ *
+ * Unlike stream or regex based parsing, this performs no allocation on the success path: the value
+ * is read with std::from_chars and the unit is looked up in a compile-time table.
+ */
+inline DurationParseResult parse_duration(std::string_view input) {
+  constexpr std::string_view whitespace{" \t\n\r"};
+
+  // trim leading and trailing whitespace
+  auto first = input.find_first_not_of(whitespace);
+  auto last = input.find_last_not_of(whitespace);
+  auto trimmed = first == std::string_view::npos ? std::string_view{} : input.substr(first, last - first + 1);
+
+  if (trimmed.empty()) {
+    return DurationParseResult::failure("The empty string is not a valid time!");
+  }
+  if (trimmed.front() == '-') {
+    return DurationParseResult::failure("Negative values are not a valid time!");
+  }
+  if (trimmed.size() == 7 && std::equal(trimmed.begin(), trimmed.end(), "forever",
+                                        [](char a, char b) { return std::tolower(a) == b; })) {
+    return DurationParseResult::success(reactor::Duration::max());
+  }
+
+  double value{0.0};
+  auto consumed = read_double(trimmed, value);
+  if (consumed == 0) {
+    return DurationParseResult::failure("Not a valid time value!");
+  }
+
+  auto unit = trimmed.substr(consumed);
+  auto unit_first = unit.find_first_not_of(whitespace);
+  unit = unit_first == std::string_view::npos ? std::string_view{} : unit.substr(unit_first);
+
+  if (unit.empty()) {
+    if (value == 0.0) {
+      return DurationParseResult::success(reactor::Duration::zero());
+    }
+    return DurationParseResult::failure("No unit given!");
+  }
+
+  for (const auto& entry : time_units) {
+    if (entry.unit == unit) {
+      std::chrono::duration<double, std::nano> tmp{value * entry.nanoseconds};
+      return DurationParseResult::success(std::chrono::duration_cast<reactor::Duration>(tmp));
+    }
+  }
+  return DurationParseResult::failure("Not a valid unit: " + std::string(unit));
+}
+
+} // namespace lfutil
+
 class argument_incorrect_type_with_reason : public cxxopts::OptionParseException {
 public:
   explicit argument_incorrect_type_with_reason(const std::string& arg, const std::string& reason)
@@ -69,62 +222,15 @@ template <typename T> std::string any_to_string(const T val) {
 }
 
 std::stringstream& operator>>(std::stringstream& in, reactor::Duration& dur) {
-  double value;
-  std::string unit;
-
-  const std::string validation_msg = validate_time_string(in.str());
-  if (!validation_msg.empty()) {
+  auto result = lfutil::parse_duration(in.str());
+  if (!result) {
     // throw cxxopts error
-    throw argument_incorrect_type_with_reason(in.str(), validation_msg);
-  }
-
-  if (iequals(in.str(), "forever")) {
-    in >> unit; // parse the entire string
-    dur = reactor::Duration::max();
-    return in;
-  }
-
-  // try to read as double
-  in >> value;
-
-  if (value == 0.0) {
-    dur = reactor::Duration::zero();
-    if (!in.eof()) {
-      // parse whatever remains
-      in >> unit;
-    }
-  } else {
-    in >> unit;
-    if (unit == "nsec" || unit == "nsecs" || unit == "ns") {
-      std::chrono::duration<double, std::nano> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "usec" || unit == "usecs" || unit == "us") {
-      std::chrono::duration<double, std::micro> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "msec" || unit == "msecs" || unit == "ms") {
-      std::chrono::duration<double, std::milli> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "sec" || unit == "secs" || unit == "second" || unit == "seconds" || unit == "s") {
-      std::chrono::duration<double, std::ratio<1, 1>> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "min" || unit == "mins" || unit == "minute" || unit == "minutes" || unit == "m") {
-      std::chrono::duration<double, std::ratio<60, 1>> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "hour" || unit == "hours" || unit == "h") {
-      std::chrono::duration<double, std::ratio<3600, 1>> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "day" || unit == "days" || unit == "d") {
-      std::chrono::duration<double, std::ratio<24 * 3600, 1>> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else if (unit == "week" || unit == "weeks" || unit == "w") {
-      std::chrono::duration<double, std::ratio<7 * 24 * 3600, 1>> tmp{value};
-      dur = std::chrono::duration_cast<reactor::Duration>(tmp);
-    } else {
-      // mark as error
-      in.setstate(std::ifstream::failbit);
-    }
+    throw argument_incorrect_type_with_reason(in.str(), result.error());
   }
 
+  dur = result.value();
+  // mark the entire stream as consumed
+  in.seekg(0, std::ios_base::end);
   return in;
 }
 
@@ -132,33 +238,6 @@ std::stringstream& operator>>(std::stringstream& in, reactor::Duration& dur) {
  *   Tests for correct syntax in unit usage for time strings
  **/
 std::string validate_time_string(const std::string& time) {
-  auto trimmed = std::regex_replace(time, std::regex("^ +| +$|( ) +"), "$1");
-  if (trimmed.size() == 0) {
-    return "The empty string is not a valid time!";
-  } else if (trimmed[0] == '-') {
-    return "Negative values are not a valid time!";
-  } else if (iequals("forever", time)) {
-    return ""; // "forever" is a valid value
-  } else if (trimmed.find_first_not_of("0.") == std::string::npos) {
-    return "";
-  } else {
-    auto pos = trimmed.find_first_not_of("0123456789. \n\r\t");
-    if (pos == std::string::npos) {
-      return "No unit given!";
-    } else {
-      auto unit = trimmed.substr(pos);
-      if (unit == "nsec" || unit == "nsecs" || unit == "ns" || unit == "usec" || unit == "usecs" || unit == "us" ||
-          unit == "msec" || unit == "msecs" || unit == "ms" || unit == "sec" || unit == "secs" || unit == "second" ||
-          unit == "seconds" || unit == "s" || unit == "min" || unit == "mins" || unit == "minute" ||
-          unit == "minutes" || unit == "m" || unit == "hour" || unit == "hours" || unit == "h" || unit == "day" ||
-          unit == "days" || unit == "d" || unit == "week" || unit == "weeks" || unit == "w") {
-        return "";
-      } else {
-        std::stringstream ss;
-        ss << "Not a valid unit: " << unit;
-        return ss.str();
-      }
-    }
-  }
-  return "Unexpected error!";
+  auto result = lfutil::parse_duration(time);
+  return result ? "" : result.error();
 }